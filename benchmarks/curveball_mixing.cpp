@@ -0,0 +1,107 @@
+/*
+ * Mixing of the edge swap chain of ConfigurationModelSampler against the
+ * Curveball and Global Curveball chains of CurveballSampler, starting from
+ * the same simple graph with a power-law degree sequence. The mixing is
+ * tracked with the fraction of the initial edges still present, which decays
+ * to about sum k_i k_j / 2E over the initial edges, divided by E; a chain is
+ * mixed when it comes within 0.01 of that value. One sweep is E swaps, N
+ * trades or one global trade.
+ *
+ * g++ -O3 -std=c++11 -pthread -Isrc benchmarks/curveball_mixing.cpp \
+ *     src/GraphGenerator.cpp -o curveball_mixing
+ * ./curveball_mixing [N] [sweeps] [exponent]
+ */
+
+#include "GraphGenerator.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+using namespace rggen;
+
+//fraction of the edges of edge_list in the initial edge set
+double overlap(const EdgeList& edge_list, const EdgeMultiset& initial_set)
+{
+    size_t count = 0;
+    for (auto& edge : edge_list)
+    {
+        count += initial_set.count(undirected_edge_key(edge)) > 0;
+    }
+    return double(count)/edge_list.size();
+}
+
+//run sweeps calls of sweep, print the overlap after each one and return the
+//time to reach the target overlap (0 if never reached)
+template<typename Function>
+double mixing_time(const char* name, Function sweep, size_t sweeps,
+        const EdgeMultiset& initial_set, double target)
+{
+    double elapsed = 0;
+    double time_to_mix = 0;
+    printf("%-16s", name);
+    for (size_t s = 0; s < sweeps; s++)
+    {
+        auto start = chrono::steady_clock::now();
+        EdgeList edge_list = sweep();
+        elapsed += chrono::duration<double>(
+                chrono::steady_clock::now()-start).count();
+        double current = overlap(edge_list, initial_set);
+        if (time_to_mix == 0 and current <= target)
+            time_to_mix = elapsed;
+        printf(" %6.3f", current);
+    }
+    printf("\n%-16s %.3f s per sweep\n", "", elapsed/sweeps);
+    return time_to_mix;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t N = argc > 1 ? strtoull(argv[1], nullptr, 10) : 100000;
+    size_t sweeps = argc > 2 ? strtoull(argv[2], nullptr, 10) : 10;
+    double exponent = argc > 3 ? atof(argv[3]) : 2.5;
+
+    //power-law degree sequence with a structural cutoff
+    RNGType gen(42);
+    vector<unsigned int> degree_sequence(N);
+    unsigned int max_degree = sqrt(N);
+    for (auto& degree : degree_sequence)
+    {
+        degree = min(max_degree, unsigned(
+                    2*pow(1 - random_01(gen), -1/(exponent-1))));
+    }
+    if (accumulate(degree_sequence.begin(), degree_sequence.end(), 0ul) % 2)
+        degree_sequence[0] += 1;
+    EdgeList edge_list = ConfigurationModelGenerator(degree_sequence, 42)
+        .get_graph(true);
+    size_t E = edge_list.size();
+
+    EdgeMultiset initial_set(E);
+    double target = 0;
+    for (auto& edge : edge_list)
+    {
+        initial_set.insert(undirected_edge_key(edge));
+        target += double(degree_sequence[edge.first])*
+            degree_sequence[edge.second]/(2*E);
+    }
+    target = target/E + 0.01;
+    printf("N = %zu, E = %zu, target overlap %.3f\n", N, E, target);
+
+    ConfigurationModelSampler swap_sampler(edge_list, 42);
+    CurveballSampler curveball_sampler(edge_list, 42);
+    CurveballSampler global_sampler(edge_list, 42);
+    double swap_time = mixing_time("edge swap",
+            [&]() {return swap_sampler.get_graph(E);}, sweeps, initial_set,
+            target);
+    double curveball_time = mixing_time("curveball",
+            [&]() {return curveball_sampler.get_graph(N);}, sweeps,
+            initial_set, target);
+    double global_time = mixing_time("global curveball",
+            [&]() {return global_sampler.get_graph_global(1);}, sweeps,
+            initial_set, target);
+
+    printf("\ntime to mix (s): edge swap %.3f, curveball %.3f, "
+            "global curveball %.3f\n", swap_time, curveball_time,
+            global_time);
+    return 0;
+}
@@ -0,0 +1,129 @@
+/*
+ * Throughput of the edge swaps of ConfigurationModelSampler on simple
+ * graphs, against the same chain with the edges kept in a std::set. The
+ * std::set chain is only run up to 1e7 edges.
+ *
+ * g++ -O3 -std=c++11 -pthread -Isrc benchmarks/edge_swap_throughput.cpp \
+ *     src/GraphGenerator.cpp -o edge_swap_throughput
+ * ./edge_swap_throughput [swaps] [edges ...]
+ */
+
+#include "GraphGenerator.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+using namespace rggen;
+
+//edge swap chain of the sampler with the edges kept in a std::set
+class SetSampler
+{
+public:
+    SetSampler(EdgeList edge_list, unsigned int seed) :
+        gen_(seed), edge_list_(move(edge_list)),
+        edge_set_(edge_list_.begin(), edge_list_.end()) {}
+
+    void edge_swap()
+    {
+        size_t index1 = random_int(edge_list_.size(), gen_);
+        Edge e1 = edge_list_[index1];
+        swap(edge_list_[index1], edge_list_.back());
+        edge_list_.pop_back();
+        edge_set_.erase(e1);
+
+        size_t index2 = random_int(edge_list_.size(), gen_);
+        Edge e2 = edge_list_[index2];
+        while (e2 == e1)
+        {
+            index2 = random_int(edge_list_.size(), gen_);
+            e2 = edge_list_[index2];
+        }
+        swap(edge_list_[index2], edge_list_.back());
+        edge_list_.pop_back();
+        edge_set_.erase(e2);
+
+        int choice = random_int(2, gen_);
+        if (choice)
+            swap(e2.second, e1.second);
+        else
+            swap(e2.second, e1.first);
+        if (e1.first == e1.second or e2.first == e2.second or exists(e1) or
+                exists(e2))
+        {
+            if (choice)
+                swap(e2.second, e1.second);
+            else
+                swap(e2.second, e1.first);
+        }
+
+        edge_set_.insert(e1);
+        edge_set_.insert(e2);
+        edge_list_.push_back(e1);
+        edge_list_.push_back(e2);
+    }
+
+private:
+    bool exists(const Edge& e) const
+    {
+        return edge_set_.count(e) or
+            edge_set_.count(Edge(e.second, e.first));
+    }
+
+    RNGType gen_;
+    EdgeList edge_list_;
+    EdgeSet edge_set_;
+};
+
+template<typename Function>
+double swaps_per_second(Function edge_swap, size_t swaps)
+{
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < swaps; i++)
+    {
+        edge_swap();
+    }
+    return swaps/chrono::duration<double>(
+            chrono::steady_clock::now()-start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    size_t swaps = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    vector<size_t> edges;
+    for (int i = 2; i < argc; i++)
+    {
+        edges.push_back(strtoull(argv[i], nullptr, 10));
+    }
+    if (edges.empty())
+        edges = {1000000, 100000000};
+
+    printf("%12s %14s %14s %8s\n", "edges", "set (swaps/s)",
+            "hash (swaps/s)", "speedup");
+    for (size_t E : edges)
+    {
+        //simple random 10-regular graph
+        vector<unsigned int> degree_sequence(E/5, 10);
+        ConfigurationModelGenerator generator(degree_sequence, 42);
+        EdgeList edge_list = generator.get_graph(true);
+
+        double set_rate = 0;
+        if (E <= 10000000)
+        {
+            SetSampler set_sampler(edge_list, 42);
+            set_rate = swaps_per_second([&]() {set_sampler.edge_swap();},
+                    swaps);
+        }
+        ConfigurationModelSampler sampler(move(edge_list), 42);
+        auto start = chrono::steady_clock::now();
+        sampler.get_graph(swaps);
+        double hash_rate = swaps/chrono::duration<double>(
+                chrono::steady_clock::now()-start).count();
+        if (set_rate > 0)
+            printf("%12zu %14.3g %14.3g %8.1f\n", E, set_rate, hash_rate,
+                    hash_rate/set_rate);
+        else
+            printf("%12zu %14s %14.3g %8s\n", E, "-", hash_rate, "-");
+    }
+    return 0;
+}
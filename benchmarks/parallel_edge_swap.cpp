@@ -0,0 +1,45 @@
+/*
+ * Scaling of ConfigurationModelSampler::get_graph_parallel with the number of
+ * threads, on a simple random 10-regular graph. The number of threads is
+ * doubled from 1 up to max_threads.
+ *
+ * g++ -O3 -std=c++11 -pthread -Isrc benchmarks/parallel_edge_swap.cpp \
+ *     src/GraphGenerator.cpp -o parallel_edge_swap
+ * ./parallel_edge_swap [edges] [swaps] [max_threads]
+ */
+
+#include "GraphGenerator.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+using namespace rggen;
+
+int main(int argc, char* argv[])
+{
+    size_t E = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    size_t swaps = argc > 2 ? strtoull(argv[2], nullptr, 10) : 10*E;
+    unsigned int max_threads = argc > 3 ? atoi(argv[3]) : 64;
+
+    vector<unsigned int> degree_sequence(E/5, 10);
+    ConfigurationModelGenerator generator(degree_sequence, 42);
+    EdgeList edge_list = generator.get_graph(true);
+
+    printf("%8s %10s %14s %8s\n", "threads", "time (s)", "swaps/s",
+            "speedup");
+    double reference = 0;
+    for (unsigned int n_threads = 1; n_threads <= max_threads; n_threads *= 2)
+    {
+        ConfigurationModelSampler sampler(edge_list, 42);
+        auto start = chrono::steady_clock::now();
+        sampler.get_graph_parallel(swaps, n_threads);
+        double elapsed = chrono::duration<double>(
+                chrono::steady_clock::now()-start).count();
+        if (n_threads == 1)
+            reference = elapsed;
+        printf("%8u %10.3f %14.3g %8.2f\n", n_threads, elapsed,
+                swaps/elapsed, reference/elapsed);
+    }
+    return 0;
+}
@@ -0,0 +1,76 @@
+/*
+ * Rewiring of configuration model multigraphs into simple graphs: sort-based
+ * passes against the hash multiset and worklist, on power-law degree
+ * sequences with a structural cutoff sqrt(N).
+ *
+ * g++ -O3 -std=c++11 -pthread -Isrc benchmarks/simple_graph_repair.cpp \
+ *     src/GraphGenerator.cpp -o simple_graph_repair
+ * ./simple_graph_repair [N]
+ */
+
+#include "GraphGenerator.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+using namespace rggen;
+
+//power-law degree sequence with even sum
+vector<unsigned int> power_law_sequence(size_t N, double exponent,
+        unsigned int kmin, unsigned int kmax, RNGType& gen)
+{
+    vector<double> cumulative;
+    double sum = 0;
+    for (unsigned int k = kmin; k <= kmax; k++)
+    {
+        sum += pow(k, -exponent);
+        cumulative.push_back(sum);
+    }
+    vector<unsigned int> degree_sequence(N);
+    size_t stubs = 0;
+    for (auto& degree : degree_sequence)
+    {
+        double u = random_01(gen)*sum;
+        degree = kmin + (lower_bound(cumulative.begin(), cumulative.end(), u)
+                - cumulative.begin());
+        stubs += degree;
+    }
+    if (stubs % 2)
+        degree_sequence[0] += 1;
+    return degree_sequence;
+}
+
+template<typename Function>
+double time_repair(Function repair, EdgeList edge_list, RNGType& gen)
+{
+    auto start = chrono::steady_clock::now();
+    repair(edge_list, gen);
+    return chrono::duration<double>(chrono::steady_clock::now()-start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    size_t N = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000000;
+    RNGType gen(42);
+    printf("%8s %12s %12s %12s %8s\n", "exponent", "edges", "sorted (s)",
+            "hash (s)", "speedup");
+    for (double exponent : {2.1, 2.2, 2.3, 2.4, 2.5})
+    {
+        vector<unsigned int> degree_sequence = power_law_sequence(N,
+                exponent, 2, sqrt(N), gen);
+        ConfigurationModelGenerator generator(degree_sequence, 42);
+        EdgeList edge_list = generator.get_graph(false);
+        double sorted = time_repair([](EdgeList& edges, RNGType& gen)
+                {
+                    rewire_faulty_edges_sorted(edges, gen);
+                }, edge_list, gen);
+        double hash = time_repair([](EdgeList& edges, RNGType& gen)
+                {
+                    rewire_faulty_edges(edges, gen);
+                }, edge_list, gen);
+        printf("%8.1f %12zu %12.3f %12.3f %8.1f\n", exponent,
+                edge_list.size(), sorted, hash, sorted/hash);
+    }
+    return 0;
+}
@@ -0,0 +1,53 @@
+/*
+ * Edge swaps of ConfigurationModelSampler with a Metropolis rule towards a
+ * target transitivity, starting from a simple random 10-regular graph. The
+ * transitivity and the swap rate are printed every E/10 swaps. beta is given
+ * in units of the number of connected triples over 3, so that creating or
+ * destroying one triangle changes the weight by about exp(-beta).
+ *
+ * g++ -O3 -std=c++11 -pthread -Isrc benchmarks/target_transitivity.cpp \
+ *     src/GraphGenerator.cpp -o target_transitivity
+ * ./target_transitivity [edges] [swaps] [transitivity] [beta]
+ */
+
+#include "GraphGenerator.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+using namespace rggen;
+
+int main(int argc, char* argv[])
+{
+    size_t E = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    size_t swaps = argc > 2 ? strtoull(argv[2], nullptr, 10) : E;
+    double target = argc > 3 ? atof(argv[3]) : 0.1;
+    double beta = argc > 4 ? atof(argv[4]) : 5;
+
+    vector<unsigned int> degree_sequence(E/5, 10);
+    ConfigurationModelGenerator generator(degree_sequence, 42);
+    ConfigurationModelSampler sampler(generator.get_graph(true), 42);
+    double triples = 45.*degree_sequence.size();
+
+    auto start = chrono::steady_clock::now();
+    sampler.set_target_transitivity(target, beta*triples/3);
+    double setup = chrono::duration<double>(
+            chrono::steady_clock::now()-start).count();
+    printf("E = %zu, setup %.3f s, initial transitivity %.5f\n", E, setup,
+            sampler.transitivity());
+
+    printf("%12s %14s %14s\n", "swaps", "transitivity", "swaps/s");
+    size_t chunk = max(E/10, size_t(1));
+    for (size_t done = 0; done < swaps; done += chunk)
+    {
+        size_t step = min(chunk, swaps - done);
+        start = chrono::steady_clock::now();
+        sampler.get_graph(step);
+        double elapsed = chrono::duration<double>(
+                chrono::steady_clock::now()-start).count();
+        printf("%12zu %14.5f %14.3g\n", done + step, sampler.transitivity(),
+                step/elapsed);
+    }
+    return 0;
+}
@@ -0,0 +1,37 @@
+"""
+Speedup of independent generators running on a pool of Python threads.
+
+Usage: python benchmarks/thread_scaling.py [max_threads]
+"""
+
+import sys
+import time
+from concurrent.futures import ThreadPoolExecutor
+import rggen
+
+N = 200000
+REALIZATIONS = 16
+
+
+def run(n_threads, degree_sequence):
+    generators = [rggen.ConfigurationModelGenerator(degree_sequence, seed)
+                  for seed in range(REALIZATIONS)]
+    start = time.perf_counter()
+    with ThreadPoolExecutor(max_workers=n_threads) as executor:
+        list(executor.map(lambda g: g.get_graph(True, output='array'),
+                          generators))
+    return time.perf_counter() - start
+
+
+if __name__ == '__main__':
+    max_threads = int(sys.argv[1]) if len(sys.argv) > 1 else 8
+    degree_sequence = rggen.power_law_sequence(N, 2, 1000, 2.5)
+    if sum(degree_sequence) % 2:
+        degree_sequence[0] += 1
+    reference = run(1, degree_sequence)
+    n_threads = 1
+    while n_threads <= max_threads:
+        elapsed = run(n_threads, degree_sequence)
+        print("{:3d} threads: {:8.3f} s  speedup {:5.2f}".format(
+            n_threads, elapsed, reference/elapsed))
+        n_threads *= 2
@@ -1,2 +1,3 @@
 from .utility import *
 from _rggen import *
+from .generators import *
@@ -0,0 +1,200 @@
+"""
+Generators with the width of the node indices chosen from the input size.
+The classes keep their names (the 32 bits versions); the make_* functions
+return an instance of the 32 or 64 bits class.
+"""
+
+import numpy as np
+import _rggen
+
+#number of nodes that can be indexed with 32 bits integers
+MAX_NODES_32 = 2**32
+
+
+def _node_class(name, number_of_indices, node_bits):
+    """_node_class returns the compiled class name suffixed with the number
+    of bits of its node indices: 32 bits when all the indices fit, else 64.
+
+    :param name: Name of the generator
+    :param number_of_indices: Number of node (or clique) indices needed
+    :param node_bits: None for the automatic choice, or 32 or 64
+    """
+    if node_bits is None:
+        node_bits = 32 if number_of_indices <= MAX_NODES_32 else 64
+    if node_bits not in (32, 64):
+        raise ValueError("node_bits must be None, 32 or 64")
+    if node_bits == 32 and number_of_indices > MAX_NODES_32:
+        raise ValueError("too many nodes for 32 bits node indices")
+    return getattr(_rggen, name + str(node_bits))
+
+
+def _number_of_nodes(edge_list):
+    """_number_of_nodes returns the largest node label of an edge list plus
+    one, without converting a list of tuples to an array.
+
+    :param edge_list: Edge list (or (E,2) array)
+    """
+    if len(edge_list) == 0:
+        return 0
+    if isinstance(edge_list, np.ndarray):
+        return int(edge_list.max()) + 1
+    return int(max(max(edge) for edge in edge_list)) + 1
+
+
+def make_configuration_model_generator(degree_sequence, seed=42,
+                                       node_bits=None):
+    """make_configuration_model_generator returns a configuration model
+    generator.
+
+    :param degree_sequence: Sequence (or array) of degree for the network
+    :param seed: Seed for the RNG
+    :param node_bits: Width of the node indices, 32 or 64, chosen from the
+    number of nodes if None
+    """
+    cls = _node_class("ConfigurationModelGenerator", len(degree_sequence),
+                      node_bits)
+    return cls(degree_sequence, seed)
+
+
+def make_directed_configuration_model_generator(in_degree_sequence,
+                                                out_degree_sequence, seed=42,
+                                                node_bits=None):
+    """make_directed_configuration_model_generator returns a directed
+    configuration model generator.
+
+    :param in_degree_sequence: Sequence (or array) of in-degree
+    :param out_degree_sequence: Sequence (or array) of out-degree
+    :param seed: Seed for the RNG
+    :param node_bits: Width of the node indices, 32 or 64, chosen from the
+    number of nodes if None
+    """
+    cls = _node_class("DirectedConfigurationModelGenerator",
+                      len(out_degree_sequence), node_bits)
+    return cls(in_degree_sequence, out_degree_sequence, seed)
+
+
+def make_bipartite_configuration_model_generator(membership_sequence,
+                                                 clique_size_sequence,
+                                                 seed=42, node_bits=None):
+    """make_bipartite_configuration_model_generator returns a generator of
+    the node-clique incidence graph.
+
+    :param membership_sequence: Sequence (or array) of membership for nodes
+    :param clique_size_sequence: Sequence (or array) of size for cliques
+    :param seed: Seed for the RNG
+    :param node_bits: Width of the node and clique indices, 32 or 64, chosen
+    from the number of nodes and cliques if None
+    """
+    cls = _node_class("BipartiteConfigurationModelGenerator",
+                      max(len(membership_sequence),
+                          len(clique_size_sequence)), node_bits)
+    return cls(membership_sequence, clique_size_sequence, seed)
+
+
+def make_configuration_model_sampler(edge_list, seed=42, simple_graph=True,
+                                     node_bits=None):
+    """make_configuration_model_sampler returns a MCMC sampler of the
+    configuration model starting from an edge list.
+
+    :param edge_list: Edge list (or (E,2) array) of the initial network
+    :param seed: Seed for the RNG
+    :param simple_graph: Bool indicating if the sampled graphs are simple
+    :param node_bits: Width of the node indices, 32 or 64, chosen from the
+    largest node label if None
+    """
+    cls = _node_class("ConfigurationModelSampler",
+                      _number_of_nodes(edge_list), node_bits)
+    return cls(edge_list, seed, simple_graph)
+
+
+def make_curveball_sampler(edge_list, seed=42, node_bits=None):
+    """make_curveball_sampler returns a MCMC sampler of simple graphs with
+    the degree sequence of an edge list, using Curveball trades.
+
+    :param edge_list: Edge list (or (E,2) array) of the initial simple graph
+    :param seed: Seed for the RNG
+    :param node_bits: Width of the node indices, 32 or 64, chosen from the
+    largest node label if None
+    """
+    cls = _node_class("CurveballSampler", _number_of_nodes(edge_list),
+                      node_bits)
+    return cls(edge_list, seed)
+
+
+def make_clustered_graph_generator(membership_sequence, clique_size_sequence,
+                                   seed=42, node_bits=None):
+    """make_clustered_graph_generator returns a clustered graph generator.
+
+    :param membership_sequence: Sequence (or array) of membership for nodes
+    :param clique_size_sequence: Sequence (or array) of size for cliques
+    :param seed: Seed for the RNG
+    :param node_bits: Width of the node and clique indices, 32 or 64, chosen
+    from the number of nodes and cliques if None
+    """
+    cls = _node_class("ClusteredGraphGenerator",
+                      max(len(membership_sequence),
+                          len(clique_size_sequence)), node_bits)
+    return cls(membership_sequence, clique_size_sequence, seed)
+
+
+def make_clustered_graph_sampler(membership_sequence, clique_size_sequence,
+                                 seed=42, node_bits=None):
+    """make_clustered_graph_sampler returns a MCMC sampler of clustered
+    graphs using membership swaps between cliques.
+
+    :param membership_sequence: Sequence (or array) of membership for nodes
+    :param clique_size_sequence: Sequence (or array) of size for cliques
+    :param seed: Seed for the RNG
+    :param node_bits: Width of the node and clique indices, 32 or 64, chosen
+    from the number of nodes and cliques if None
+    """
+    cls = _node_class("ClusteredGraphSampler",
+                      max(len(membership_sequence),
+                          len(clique_size_sequence)), node_bits)
+    return cls(membership_sequence, clique_size_sequence, seed)
+
+
+def make_segregated_graph_generator(membership_sequence, clique_size_sequence,
+                                    seed=42, node_bits=None):
+    """make_segregated_graph_generator returns a segregated graph generator.
+
+    :param membership_sequence: Sequence (or array) of membership for nodes
+    :param clique_size_sequence: Sequence (or array) of size for cliques
+    :param seed: Seed for the RNG
+    :param node_bits: Width of the node and clique indices, 32 or 64, chosen
+    from the number of nodes and cliques if None
+    """
+    cls = _node_class("SegregatedGraphGenerator",
+                      max(len(membership_sequence),
+                          len(clique_size_sequence)), node_bits)
+    return cls(membership_sequence, clique_size_sequence, seed)
+
+
+def make_chung_lu_generator(weight_sequence, seed=42, node_bits=None):
+    """make_chung_lu_generator returns a Chung-Lu graph generator.
+
+    :param weight_sequence: Sequence (or array) of expected degree
+    :param seed: Seed for the RNG
+    :param node_bits: Width of the node indices, 32 or 64, chosen from the
+    number of nodes if None
+    """
+    cls = _node_class("ChungLuGenerator", len(weight_sequence), node_bits)
+    return cls(weight_sequence, seed)
+
+
+def make_joint_degree_generator(degree_sequence, joint_degree_matrix,
+                                seed=42, node_bits=None):
+    """make_joint_degree_generator returns a generator of graphs with a
+    prescribed joint degree matrix.
+
+    :param degree_sequence: Sequence (or array) of degree for the network
+    :param joint_degree_matrix: Sequence of triplets (or (M,3) array) (k,l,m)
+    giving the number m of edges between nodes of degree k and l; (l,k) is
+    either omitted or equal (symmetric matrix)
+    :param seed: Seed for the RNG
+    :param node_bits: Width of the node indices, 32 or 64, chosen from the
+    number of nodes if None
+    """
+    cls = _node_class("JointDegreeGenerator", len(degree_sequence),
+                      node_bits)
+    return cls(degree_sequence, joint_degree_matrix, seed)
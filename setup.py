@@ -83,10 +83,14 @@ class BuildExt(build_ext):
             opts.append(cpp_flag(self.compiler))
             if has_flag(self.compiler, '-fvisibility=hidden'):
                 opts.append('-fvisibility=hidden')
+            if has_flag(self.compiler, '-pthread'):
+                opts.append('-pthread')
         elif ct == 'msvc':
             opts.append('/DVERSION_INFO=\\"%s\\"' % self.distribution.get_version())
         for ext in self.extensions:
             ext.extra_compile_args = opts
+            if '-pthread' in opts:
+                ext.extra_link_args = ['-pthread']
         build_ext.build_extensions(self)
 
 setup(
@@ -99,7 +103,7 @@ setup(
     long_description='',
     packages=setuptools.find_packages(),
     ext_modules=ext_modules,
-    install_requires=['pybind11>=2.2'],
+    install_requires=['pybind11>=2.2', 'numpy'],
     cmdclass={'build_ext': BuildExt},
     zip_safe=False,
 )
@@ -35,125 +35,996 @@ namespace rggen
  * ======================================== */
 
 //Constructor of configuration model generator
-ConfigurationModelGenerator::ConfigurationModelGenerator(
-        const vector<unsigned int>& degree_sequence, unsigned int seed) :
-    gen_(seed), degree_sequence_(degree_sequence)
+template<typename NodeType>
+BasicConfigurationModelGenerator<NodeType>::BasicConfigurationModelGenerator(
+        vector<unsigned int> degree_sequence, unsigned int seed) :
+    seed_(seed), gen_(seed), degree_sequence_(move(degree_sequence)),
+    graphical_(false), max_rewiring_(0), max_seconds_(0),
+    status_(RepairStatus::SUCCESS)
 {
+    if (accumulate(degree_sequence_.begin(), degree_sequence_.end(),
+                size_t(0)) % 2)
+    {
+        throw invalid_argument("The sum of the degree sequence must be even");
+    }
+    graphical_ = rggen::is_graphical(degree_sequence_);
 }
 
 //Generates configuration model instance
-EdgeList ConfigurationModelGenerator::get_graph(
-        bool simple_graph)
+template<typename NodeType>
+BasicEdgeList<NodeType> BasicConfigurationModelGenerator<NodeType>::get_graph(
+        bool simple_graph, unsigned int n_threads)
 {
-    EdgeList edge_list;
+    return sample_graph(gen_, simple_graph, n_threads, status_);
+}
+
+//Generates configuration model instance as a CSR adjacency
+template<typename NodeType>
+BasicCSRGraph<NodeType>
+    BasicConfigurationModelGenerator<NodeType>::get_graph_csr(bool simple_graph,
+        unsigned int n_threads)
+{
+    return edge_list_to_csr(sample_graph(gen_, simple_graph, n_threads,
+                status_), degree_sequence_);
+}
+
+//Generates erased configuration model instance: the self-loops and
+//multiedges of a multigraph are removed instead of being rewired
+template<typename NodeType>
+pair<BasicEdgeList<NodeType>,ErasedEdges>
+    BasicConfigurationModelGenerator<NodeType>::get_erased_graph(
+        unsigned int n_threads)
+{
+    EdgeList edge_list = sample_graph(gen_, false, n_threads, status_);
+    ErasedEdges erased_edges = {0, 0};
+
+    //pack the edges that are not self-loops, then sort and remove duplicates
+    vector<typename EdgeKey<Node>::type> keys;
+    keys.reserve(edge_list.size());
+    for (auto& edge : edge_list)
+    {
+        if (edge.first == edge.second)
+            erased_edges.self_loops += 1;
+        else
+            keys.push_back(edge_key(edge));
+    }
+    radix_sort(keys);
+    keys.erase(unique(keys.begin(), keys.end()), keys.end());
+    erased_edges.multiedges = edge_list.size() - erased_edges.self_loops -
+        keys.size();
 
-    // Generate the stubs list
-    vector<Node> stub_list;
-    for (Node i=0; i < degree_sequence_.size(); i++)
+    edge_list.resize(keys.size());
+    for (size_t i = 0; i < keys.size(); i++)
     {
-        for (unsigned int j=0; j<degree_sequence_[i]; j++)
+        edge_list[i] = key_edge<Node>(keys[i]);
+    }
+    edge_list.shrink_to_fit();
+    return make_pair(move(edge_list), erased_edges);
+}
+
+//Generates k configuration model instances in parallel, the realization i
+//uses the stream i of the RNG seeded with seed_. Throws if the repair budget
+//is exhausted for one of the realizations.
+template<typename NodeType>
+pair<BasicEdgeList<NodeType>,vector<size_t>>
+    BasicConfigurationModelGenerator<NodeType>::get_graphs(
+        size_t k, unsigned int n_threads, bool simple_graph) const
+{
+    vector<EdgeList> edge_list_vector(k);
+    parallel_for(k, n_threads, [&](size_t begin, size_t end)
+            {
+                RepairStatus status;
+                for (size_t i = begin; i < end; i++)
+                {
+                    RNGType gen(seed_, i);
+                    edge_list_vector[i] = sample_graph(gen, simple_graph, 1,
+                            status);
+                    if (status != RepairStatus::SUCCESS)
+                    {
+                        throw runtime_error("Rewiring budget exhausted");
+                    }
+                }
+            });
+    return concatenate(edge_list_vector);
+}
+
+//Generates configuration model instance with a given RNG. The stubs are
+//written directly in the memory of the edge list, shuffled, and adjacent
+//stubs are connected.
+template<typename NodeType>
+BasicEdgeList<NodeType>
+    BasicConfigurationModelGenerator<NodeType>::sample_graph(RNGType& gen,
+        bool simple_graph, unsigned int n_threads, RepairStatus& status) const
+{
+    if (simple_graph and not graphical_)
+    {
+        throw invalid_argument(
+                "The degree sequence is not graphical, no simple graph exists");
+    }
+
+    size_t number_of_stubs = accumulate(degree_sequence_.begin(),
+            degree_sequence_.end(), size_t(0));
+
+    // Generate the stubs list and shuffle it
+    vector<Node> stub_list(number_of_stubs);
+    if (number_of_stubs < PARALLEL_SHUFFLE_THRESHOLD)
+    {
+        fill_stubs(degree_sequence_, stub_list.data(), 1);
+        shuffle(stub_list.begin(), stub_list.end(), gen);
+    }
+    else
+    {
+        vector<Node> unshuffled_stub_list(number_of_stubs);
+        fill_stubs(degree_sequence_, unshuffled_stub_list.data(), n_threads);
+        parallel_shuffle(unshuffled_stub_list.data(), stub_list.data(),
+                number_of_stubs, gen, n_threads);
+    }
+
+    // Consecutive stubs are matched, smaller node label first
+    EdgeList edge_list(number_of_stubs/2);
+    parallel_for(edge_list.size(), n_threads, [&](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; i++)
+                {
+                    edge_list[i].first = min(stub_list[2*i],
+                            stub_list[2*i+1]);
+                    edge_list[i].second = max(stub_list[2*i],
+                            stub_list[2*i+1]);
+                }
+            });
+    vector<Node>().swap(stub_list);
+
+    status = RepairStatus::SUCCESS;
+    if (simple_graph)
+    {
+        status = rewire_faulty_edges(edge_list, gen, max_rewiring_,
+                max_seconds_);
+    }
+
+    return edge_list;
+}
+
+/* ========================================
+ * Simple graph repair
+ * ======================================== */
+
+//rewire the self-loops and multiedges of an edge list, each pass sorts the
+//whole edge list to find the repeated edges
+template<typename NodeType>
+void rewire_faulty_edges_sorted(BasicEdgeList<NodeType>& edge_list,
+        RNGType& gen)
+{
+    typedef NodeType Node;
+    // Check for self-loops and repeated edges
+    bool faulty_links = true;
+    while (faulty_links)
+    {
+        faulty_links = false;
+        sort(edge_list.begin(),edge_list.end());
+        for (size_t edge1=0; edge1<edge_list.size(); edge1++)
         {
-            stub_list.push_back(i);
+            Node node1a = edge_list[edge1].first;
+            Node node1b = edge_list[edge1].second;
+            // If the link is faulty, rewire the stubs
+            if (node1a == node1b || edge_list[edge1] == edge_list[(edge1+1)
+                    % edge_list.size()])
+            {
+                faulty_links = true;
+                size_t edge2 = random_int(edge_list.size(), gen);
+                Node node2a = edge_list[edge2].first;
+                Node node2b = edge_list[edge2].second;
+                // Switch stubs
+                int choice = random_int(2, gen);
+                if (choice)
+                {
+                    edge_list[edge1].second = node2b;
+                    edge_list[edge2].second = node1b;
+                }
+                else
+                {
+                    edge_list[edge1].second = node2a;
+                    edge_list[edge2].first = node1b;
+                }
+                if (edge_list[edge1].first > edge_list[edge1].second)
+                {
+                    swap(edge_list[edge1].first,edge_list[edge1].second);
+                }
+                if (edge_list[edge2].first > edge_list[edge2].second)
+                {
+                    swap(edge_list[edge2].first,edge_list[edge2].second);
+                }
+            }
+        }
+    }
+}
+
+//Erdos-Gallai test on the degree sequence sorted with a counting sort. With
+//d sorted in decreasing order, for each k,
+//sum_{i<=k} d_i <= k(k-1) + sum_{i>k} min(d_i,k)
+bool is_graphical(const vector<unsigned int>& degree_sequence)
+{
+    size_t N = degree_sequence.size();
+    //number of nodes of each degree
+    vector<size_t> degree_count(N, 0);
+    size_t total = 0;
+    for (unsigned int degree : degree_sequence)
+    {
+        if (degree >= N)
+        {
+            return false;
+        }
+        degree_count[degree] += 1;
+        total += degree;
+    }
+    if (total % 2)
+    {
+        return false;
+    }
+
+    //sorted sequence, prefix sums and number of degrees >= k
+    vector<unsigned int> sorted_degree;
+    sorted_degree.reserve(N);
+    for (size_t degree = N; degree > 0; degree--)
+    {
+        sorted_degree.insert(sorted_degree.end(), degree_count[degree-1],
+                degree-1);
+    }
+    vector<size_t> prefix_sum(N+1, 0);
+    partial_sum(sorted_degree.begin(), sorted_degree.end(),
+            prefix_sum.begin()+1);
+    vector<size_t> at_least(N+1, 0);
+    for (size_t degree = N; degree > 0; degree--)
+    {
+        at_least[degree-1] = at_least[degree] + degree_count[degree-1];
+    }
+
+    for (size_t k = 1; k <= N; k++)
+    {
+        //the nodes i>k with d_i >= k contribute k, the others d_i
+        size_t m = max(at_least[k], k);
+        size_t right = k*(k-1) + (m-k)*k + (total - prefix_sum[m]);
+        if (prefix_sum[k] > right)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//Fulkerson-Chen-Anstee test. With the nodes sorted by decreasing out-degree
+//a_i (then in-degree b_i), for each k,
+//sum_{i<=k} a_i <= sum_{i<=k} min(b_i,k-1) + sum_{i>k} min(b_i,k)
+//The right side is sum_i min(b_i,k) minus the number of i<=k with b_i >= k,
+//which is counted with a Fenwick tree over the in-degrees.
+bool is_digraphical(const vector<unsigned int>& in_degree_sequence,
+        const vector<unsigned int>& out_degree_sequence)
+{
+    size_t N = out_degree_sequence.size();
+    if (in_degree_sequence.size() != N)
+    {
+        return false;
+    }
+    size_t total_in = 0;
+    size_t total_out = 0;
+    vector<size_t> in_degree_count(N, 0);
+    for (size_t i = 0; i < N; i++)
+    {
+        if (in_degree_sequence[i] >= N or out_degree_sequence[i] >= N)
+        {
+            return false;
+        }
+        total_in += in_degree_sequence[i];
+        total_out += out_degree_sequence[i];
+        in_degree_count[in_degree_sequence[i]] += 1;
+    }
+    if (total_in != total_out)
+    {
+        return false;
+    }
+
+    vector<size_t> order(N);
+    iota(order.begin(), order.end(), size_t(0));
+    sort(order.begin(), order.end(), [&](size_t i, size_t j)
+            {
+                return make_pair(out_degree_sequence[i],
+                        in_degree_sequence[i]) > make_pair(
+                        out_degree_sequence[j], in_degree_sequence[j]);
+            });
+
+    //tree[d] counts the nodes in the prefix with in-degree d (1-based)
+    vector<size_t> tree(N+1, 0);
+    size_t in_prefix = 0;
+    size_t left = 0;
+    size_t sum_min = 0;
+    size_t at_least = N;
+    for (size_t k = 1; k <= N; k++)
+    {
+        size_t node = order[k-1];
+        left += out_degree_sequence[node];
+        for (size_t d = in_degree_sequence[node]+1; d <= N; d += d & -d)
+        {
+            tree[d] += 1;
+        }
+        in_prefix += 1;
+        //sum_i min(b_i,k) from sum_i min(b_i,k-1)
+        at_least -= in_degree_count[k-1];
+        sum_min += at_least;
+        //prefix nodes with in-degree < k
+        size_t below = 0;
+        for (size_t d = min(k, N); d > 0; d -= d & -d)
+        {
+            below += tree[d];
+        }
+        if (left > sum_min - (in_prefix - below))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//Gale-Ryser test. With the memberships a_i sorted in decreasing order, for
+//each k, sum_{i<=k} a_i <= sum_c min(b_c,k) where b_c are the clique sizes.
+bool is_bigraphical(const vector<unsigned int>& membership_sequence,
+        const vector<unsigned int>& clique_size_sequence)
+{
+    size_t N = membership_sequence.size();
+    size_t M = clique_size_sequence.size();
+    size_t total = 0;
+    vector<size_t> membership_count(M+1, 0);
+    for (unsigned int membership : membership_sequence)
+    {
+        if (membership > M)
+        {
+            return false;
+        }
+        total += membership;
+        membership_count[membership] += 1;
+    }
+    //clique_count[k] is the number of cliques of size k
+    vector<size_t> clique_count(N+1, 0);
+    for (unsigned int size : clique_size_sequence)
+    {
+        if (size > N or size > total)
+        {
+            return false;
         }
+        total -= size;
+        clique_count[size] += 1;
+    }
+    if (total != 0)
+    {
+        return false;
     }
-    shuffle(stub_list.begin(),stub_list.end(), gen_);
 
-    // Connect the stubs at random to generate the edge list
-    while (!stub_list.empty())
+    //nodes are taken by decreasing membership, sum_c min(b_c,k) is updated
+    //from sum_c min(b_c,k-1) with the number of cliques of size >= k
+    size_t k = 0;
+    size_t left = 0;
+    size_t right = 0;
+    size_t at_least = M;
+    for (size_t a = M; a > 0; a--)
     {
-        Node stub1,stub2,node1,node2;
-        pair<Node,Node> edge;
-        stub1 = random_int(stub_list.size(), gen_);
-        node1 = stub_list[stub1];
-        swap(stub_list[stub1],stub_list[stub_list.size()-1]);
-        stub_list.pop_back();
-        stub2 = random_int(stub_list.size(), gen_);
-        node2 = stub_list[stub2];
-        swap(stub_list[stub2],stub_list[stub_list.size()-1]);
-        stub_list.pop_back();
-        if (node1 < node2)
-            edge = make_pair(node1,node2);
+        for (size_t i = 0; i < membership_count[a]; i++)
+        {
+            k += 1;
+            left += a;
+            at_least -= clique_count[k-1];
+            right += at_least;
+            if (left > right)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//rewire the self-loops and multiedges of an edge list; the edges are kept in
+//a hash multiset and the faulty edges in a worklist, so each rewiring costs
+//O(1) on average
+template<typename NodeType>
+RepairStatus rewire_faulty_edges(BasicEdgeList<NodeType>& edge_list,
+        RNGType& gen, size_t max_rewiring, double max_seconds,
+        EdgeType edge_type)
+{
+    typedef NodeType Node;
+    typedef BasicEdge<Node> Edge;
+    auto start = chrono::steady_clock::now();
+    size_t rewiring = 0;
+    if (edge_list.size() < 2)
+    {
+        return edge_list.empty() or edge_type == EdgeType::BIPARTITE or
+            edge_list[0].first != edge_list[0].second
+            ? RepairStatus::SUCCESS : RepairStatus::BUDGET_EXHAUSTED;
+    }
+    BasicEdgeMultiset<typename EdgeKey<Node>::type> edge_multiset(
+            edge_list.size());
+    for (auto& edge : edge_list)
+    {
+        edge_multiset.insert(edge_key(edge));
+    }
+    auto faulty = [&](size_t index)
+    {
+        const Edge& edge = edge_list[index];
+        return (edge.first == edge.second and
+                edge_type != EdgeType::BIPARTITE) or
+            edge_multiset.count(edge_key(edge)) > 1;
+    };
+
+    //an edge that becomes faulty is pushed in the worklist, and is checked
+    //again when it is popped
+    vector<size_t> worklist;
+    for (size_t edge1 = 0; edge1 < edge_list.size(); edge1++)
+    {
+        if (faulty(edge1))
+        {
+            worklist.push_back(edge1);
+        }
+    }
+
+    while (not worklist.empty())
+    {
+        size_t edge1 = worklist.back();
+        worklist.pop_back();
+        if (not faulty(edge1))
+        {
+            continue;
+        }
+        //check the budget, the clock is read every 1024 rewirings
+        if ((max_rewiring and rewiring == max_rewiring) or (max_seconds and
+                    rewiring % 1024 == 0 and chrono::duration<double>(
+                        chrono::steady_clock::now() - start).count()
+                    > max_seconds))
+        {
+            return RepairStatus::BUDGET_EXHAUSTED;
+        }
+        rewiring += 1;
+        size_t edge2 = random_int(edge_list.size(), gen);
+        while (edge2 == edge1)
+        {
+            edge2 = random_int(edge_list.size(), gen);
+        }
+        edge_multiset.erase(edge_key(edge_list[edge1]));
+        edge_multiset.erase(edge_key(edge_list[edge2]));
+        Node node1b = edge_list[edge1].second;
+        Node node2a = edge_list[edge2].first;
+        Node node2b = edge_list[edge2].second;
+        // Switch stubs, only the second element for directed and bipartite
+        int choice = edge_type != EdgeType::UNDIRECTED ? 1 :
+            random_int(2, gen);
+        if (choice)
+        {
+            edge_list[edge1].second = node2b;
+            edge_list[edge2].second = node1b;
+        }
         else
-            edge = make_pair(node2,node1);
-        edge_list.push_back(edge);
+        {
+            edge_list[edge1].second = node2a;
+            edge_list[edge2].first = node1b;
+        }
+        for (size_t edge : {edge1, edge2})
+        {
+            if (edge_type == EdgeType::UNDIRECTED and
+                    edge_list[edge].first > edge_list[edge].second)
+            {
+                swap(edge_list[edge].first,edge_list[edge].second);
+            }
+            edge_multiset.insert(edge_key(edge_list[edge]));
+        }
+        for (size_t edge : {edge1, edge2})
+        {
+            if (faulty(edge))
+            {
+                worklist.push_back(edge);
+            }
+        }
+    }
+    return RepairStatus::SUCCESS;
+}
+
+/* ========================================
+ * Directed configuration model generator
+ * ======================================== */
+
+//Constructor of directed configuration model generator
+template<typename NodeType>
+BasicDirectedConfigurationModelGenerator<NodeType>::
+    BasicDirectedConfigurationModelGenerator(
+        vector<unsigned int> in_degree_sequence,
+        vector<unsigned int> out_degree_sequence, unsigned int seed) :
+    gen_(seed), in_degree_sequence_(move(in_degree_sequence)),
+    out_degree_sequence_(move(out_degree_sequence)), graphical_(false),
+    max_rewiring_(0), max_seconds_(0), status_(RepairStatus::SUCCESS)
+{
+    if (in_degree_sequence_.size() != out_degree_sequence_.size())
+    {
+        throw invalid_argument(
+                "In and out-degree sequences must have the same size");
+    }
+    if (accumulate(in_degree_sequence_.begin(), in_degree_sequence_.end(),
+                size_t(0)) != accumulate(out_degree_sequence_.begin(),
+                out_degree_sequence_.end(), size_t(0)))
+    {
+        throw invalid_argument(
+                "In and out-degree sequences do not have the same sum");
+    }
+    graphical_ = is_digraphical(in_degree_sequence_, out_degree_sequence_);
+}
+
+//Generates directed configuration model instance. The sources are the
+//out-stubs in order, and the targets a random permutation of the in-stubs.
+template<typename NodeType>
+BasicEdgeList<NodeType>
+    BasicDirectedConfigurationModelGenerator<NodeType>::get_graph(
+        bool simple_graph,
+        unsigned int n_threads)
+{
+    if (simple_graph and not graphical_)
+    {
+        throw invalid_argument("The degree sequences are not digraphical, "
+                "no simple directed graph exists");
+    }
+    size_t number_of_arcs = accumulate(out_degree_sequence_.begin(),
+            out_degree_sequence_.end(), size_t(0));
+
+    //shuffle the in-stubs
+    vector<Node> in_stub_list(number_of_arcs);
+    fill_stubs(in_degree_sequence_, in_stub_list.data(), n_threads);
+    if (number_of_arcs >= PARALLEL_SHUFFLE_THRESHOLD)
+    {
+        vector<Node> shuffled_in_stub_list(number_of_arcs);
+        parallel_shuffle(in_stub_list.data(), shuffled_in_stub_list.data(),
+                number_of_arcs, gen_, n_threads);
+        in_stub_list.swap(shuffled_in_stub_list);
+    }
+    else
+    {
+        shuffle(in_stub_list.begin(), in_stub_list.end(), gen_);
+    }
+    vector<Node> out_stub_list(number_of_arcs);
+    fill_stubs(out_degree_sequence_, out_stub_list.data(), n_threads);
+    EdgeList edge_list(number_of_arcs);
+    parallel_for(number_of_arcs, n_threads, [&](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; i++)
+                {
+                    edge_list[i].first = out_stub_list[i];
+                    edge_list[i].second = in_stub_list[i];
+                }
+            });
+
+    status_ = RepairStatus::SUCCESS;
+    if (simple_graph)
+    {
+        status_ = rewire_faulty_edges(edge_list, gen_, max_rewiring_,
+                max_seconds_, EdgeType::DIRECTED);
+    }
+    return edge_list;
+}
+
+//Generates directed configuration model instance as a CSR adjacency of the
+//out-neighbors
+template<typename NodeType>
+BasicCSRGraph<NodeType>
+    BasicDirectedConfigurationModelGenerator<NodeType>::get_graph_csr(
+        bool simple_graph, unsigned int n_threads)
+{
+    return edge_list_to_csr(get_graph(simple_graph, n_threads),
+            out_degree_sequence_, true);
+}
+
+/* ========================================
+ * Bipartite configuration model generator
+ * ======================================== */
+
+//Constructor of bipartite configuration model generator
+template<typename NodeType>
+BasicBipartiteConfigurationModelGenerator<NodeType>::
+    BasicBipartiteConfigurationModelGenerator(
+        vector<unsigned int> membership_sequence,
+        vector<unsigned int> clique_size_sequence, unsigned int seed) :
+    gen_(seed), membership_sequence_(move(membership_sequence)),
+    clique_size_sequence_(move(clique_size_sequence)), graphical_(false),
+    max_rewiring_(0), max_seconds_(0), status_(RepairStatus::SUCCESS)
+{
+    if (accumulate(clique_size_sequence_.begin(), clique_size_sequence_.end(),
+                size_t(0)) != accumulate(membership_sequence_.begin(),
+                membership_sequence_.end(), size_t(0)))
+    {
+        throw invalid_argument(
+                "Membership and clique size sequence do not match");
+    }
+    graphical_ = is_bigraphical(membership_sequence_, clique_size_sequence_);
+}
+
+//Generates bipartite configuration model instance. The nodes are the node
+//stubs in order, and the cliques a random permutation of the clique stubs.
+template<typename NodeType>
+BasicEdgeList<NodeType>
+    BasicBipartiteConfigurationModelGenerator<NodeType>::get_graph(
+        bool simple_graph,
+        unsigned int n_threads)
+{
+    if (simple_graph and not graphical_)
+    {
+        throw invalid_argument("The sequences are not bigraphical, "
+                "no simple bipartite graph exists");
     }
+    size_t number_of_stubs = accumulate(membership_sequence_.begin(),
+            membership_sequence_.end(), size_t(0));
 
+    //shuffle the clique stubs
+    vector<Node> clique_stub_list(number_of_stubs);
+    fill_stubs(clique_size_sequence_, clique_stub_list.data(), n_threads);
+    if (number_of_stubs >= PARALLEL_SHUFFLE_THRESHOLD)
+    {
+        vector<Node> shuffled_clique_stub_list(number_of_stubs);
+        parallel_shuffle(clique_stub_list.data(),
+                shuffled_clique_stub_list.data(), number_of_stubs, gen_,
+                n_threads);
+        clique_stub_list.swap(shuffled_clique_stub_list);
+    }
+    else
+    {
+        shuffle(clique_stub_list.begin(), clique_stub_list.end(), gen_);
+    }
+    vector<Node> node_stub_list(number_of_stubs);
+    fill_stubs(membership_sequence_, node_stub_list.data(), n_threads);
+    EdgeList edge_list(number_of_stubs);
+    parallel_for(number_of_stubs, n_threads, [&](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; i++)
+                {
+                    edge_list[i].first = node_stub_list[i];
+                    edge_list[i].second = clique_stub_list[i];
+                }
+            });
+
+    status_ = RepairStatus::SUCCESS;
     if (simple_graph)
     {
-        // Check for self-loops and repeated edges
-        bool faulty_links = true;
-        while (faulty_links)
+        status_ = rewire_faulty_edges(edge_list, gen_, max_rewiring_,
+                max_seconds_, EdgeType::BIPARTITE);
+    }
+    return edge_list;
+}
+
+//Generates bipartite configuration model instance as a CSR adjacency giving
+//the cliques of each node
+template<typename NodeType>
+BasicCSRGraph<NodeType>
+    BasicBipartiteConfigurationModelGenerator<NodeType>::get_graph_csr(
+        bool simple_graph, unsigned int n_threads)
+{
+    return edge_list_to_csr(get_graph(simple_graph, n_threads),
+            membership_sequence_, true);
+}
+
+/* ========================================
+ * Joint degree generator
+ * ======================================== */
+
+//Constructor of joint degree generator, the nodes are grouped by degree
+//class and the joint degree matrix is checked against the degree sequence.
+//It admits a simple graph if m_kl <= n_k n_l and m_kk <= n_k (n_k-1)/2.
+//The matrix can be given as a triangle or as a symmetric matrix.
+template<typename NodeType>
+BasicJointDegreeGenerator<NodeType>::BasicJointDegreeGenerator(
+        vector<unsigned int> degree_sequence,
+        const JointDegreeMatrix& joint_degree_matrix, unsigned int seed) :
+    gen_(seed), degree_sequence_(move(degree_sequence)), class_offset_(),
+    class_stubs_(), class_pairs_(), graphical_(true), max_rewiring_(0),
+    max_seconds_(0), status_(RepairStatus::SUCCESS)
+{
+    //degree classes by increasing degree, class_of[k] is the class of k
+    unsigned int max_degree = 0;
+    for (unsigned int degree : degree_sequence_)
+    {
+        max_degree = max(max_degree, degree);
+    }
+    vector<size_t> stubs_of_degree(size_t(max_degree)+1, 0);
+    for (unsigned int degree : degree_sequence_)
+    {
+        stubs_of_degree[degree] += degree;
+    }
+    const size_t no_class = numeric_limits<size_t>::max();
+    vector<size_t> class_of(size_t(max_degree)+1, no_class);
+    vector<size_t> class_size;
+    class_offset_.push_back(0);
+    for (size_t k = 1; k <= max_degree; k++)
+    {
+        if (stubs_of_degree[k])
+        {
+            class_of[k] = class_offset_.size()-1;
+            class_size.push_back(stubs_of_degree[k]/k);
+            class_offset_.push_back(class_offset_.back() +
+                    stubs_of_degree[k]);
+        }
+    }
+
+    //entries of the matrix, the repeated entries are merged
+    map<pair<unsigned int,unsigned int>,size_t> entry_count;
+    for (auto& entry : joint_degree_matrix)
+    {
+        if (get<2>(entry))
+            entry_count[make_pair(get<0>(entry), get<1>(entry))] +=
+                get<2>(entry);
+    }
+
+    //pairs of classes, a pair of degrees given in both orders must have
+    //the same count (symmetric matrix) and is counted once
+    map<pair<size_t,size_t>,size_t> pair_count;
+    vector<size_t> used_stubs(class_offset_.size()-1, 0);
+    for (auto& entry : entry_count)
+    {
+        unsigned int k = entry.first.first;
+        unsigned int l = entry.first.second;
+        size_t count = entry.second;
+        if (k > l and entry_count.count(make_pair(l, k)))
+        {
+            if (entry_count[make_pair(l, k)] != count)
+            {
+                throw invalid_argument("The joint degree matrix has "
+                        "different counts for (k,l) and (l,k)");
+            }
+            continue;
+        }
+        if (k > max_degree or l > max_degree or class_of[k] == no_class or
+                class_of[l] == no_class)
+        {
+            throw invalid_argument("The joint degree matrix has edges "
+                    "for a degree without nodes");
+        }
+        size_t c1 = min(class_of[k], class_of[l]);
+        size_t c2 = max(class_of[k], class_of[l]);
+        pair_count[make_pair(c1, c2)] += count;
+        used_stubs[c1] += count;
+        used_stubs[c2] += count;
+    }
+    for (size_t c = 0; c+1 < class_offset_.size(); c++)
+    {
+        if (used_stubs[c] != class_offset_[c+1] - class_offset_[c])
+        {
+            throw invalid_argument("The joint degree matrix does not match "
+                    "the degree sequence");
+        }
+    }
+    for (auto& entry : pair_count)
+    {
+        size_t c1 = entry.first.first;
+        size_t c2 = entry.first.second;
+        size_t count = entry.second;
+        class_pairs_.emplace_back(c1, c2, count);
+
+        //count <= a*b without overflow
+        auto at_most = [](size_t count, size_t a, size_t b)
+            {return a > 0 and count/a + (count % a != 0) <= b;};
+        size_t n = class_size[c1];
+        if (c1 != c2)
+            graphical_ = graphical_ and at_most(count, n, class_size[c2]);
+        else if (n % 2 == 0)
+            graphical_ = graphical_ and at_most(count, n/2, n-1);
+        else
+            graphical_ = graphical_ and at_most(count, n, (n-1)/2);
+    }
+
+    //stubs grouped by class, the nodes of a class of degree k are repeated
+    //k times in the same order
+    class_stubs_.resize(class_offset_.back());
+    vector<size_t> rank(class_size.size(), 0);
+    for (size_t node = 0; node < degree_sequence_.size(); node++)
+    {
+        unsigned int degree = degree_sequence_[node];
+        if (degree)
         {
-            faulty_links = false;
-            sort(edge_list.begin(),edge_list.end());
-            for (size_t edge1=0; edge1<edge_list.size(); edge1++)
+            size_t c = class_of[degree];
+            for (size_t r = 0; r < degree; r++)
             {
-                Node node1a = edge_list[edge1].first;
-                Node node1b = edge_list[edge1].second;
-                // If the link is faulty, rewire the stubs
-                if (node1a == node1b || edge_list[edge1] == edge_list[(edge1+1)
-                        % edge_list.size()])
+                class_stubs_[class_offset_[c] + rank[c] + r*class_size[c]] =
+                    Node(node);
+            }
+            rank[c] += 1;
+        }
+    }
+}
+
+//Generates joint degree instance. The nodes of each class are shuffled with
+//its own RNG stream and repeated k times, so that the consecutive stubs given
+//to a pair of classes hold each node floor(m/n) or ceil(m/n) times; these
+//balanced degrees always admit a simple graph when the matrix does. Each pair
+//is matched (and rewired) with its own RNG stream, in parallel; the result
+//does not depend on n_threads.
+template<typename NodeType>
+BasicEdgeList<NodeType> BasicJointDegreeGenerator<NodeType>::get_graph(
+        bool simple_graph, unsigned int n_threads)
+{
+    if (simple_graph and not graphical_)
+    {
+        throw invalid_argument("The joint degree matrix is not graphical, "
+                "no simple graph exists");
+    }
+    size_t n_classes = class_offset_.size()-1;
+    uint64_t seed = draw_seed(gen_);
+    vector<Node> stubs(class_stubs_);
+    parallel_for(n_classes, n_threads, [&](size_t begin, size_t end)
+            {
+                for (size_t c = begin; c < end; c++)
                 {
-                    faulty_links = true;
-                    unsigned int edge2 = random_int(edge_list.size(), gen_);
-                    Node node2a = edge_list[edge2].first;
-                    Node node2b = edge_list[edge2].second;
-                    // Switch stubs
-                    int choice = random_int(2, gen_);
-                    if (choice)
+                    RNGType class_gen(seed, c);
+                    auto first = stubs.begin() + class_offset_[c];
+                    auto last = stubs.begin() + class_offset_[c+1];
+                    size_t size = (last - first)/
+                        degree_sequence_[*first];
+                    shuffle(first, first + size, class_gen);
+                    for (auto it = first + size; it != last; it += size)
                     {
-                        edge_list[edge1].second = node2b;
-                        edge_list[edge2].second = node1b;
+                        copy_n(first, size, it);
                     }
+                }
+            });
+
+    //position of the stubs and of the edges of each pair of classes
+    size_t n_pairs = class_pairs_.size();
+    vector<size_t> first_stub1(n_pairs);
+    vector<size_t> first_stub2(n_pairs);
+    vector<size_t> edge_offset(n_pairs+1, 0);
+    vector<size_t> cursor(class_offset_.begin(), class_offset_.end()-1);
+    for (size_t p = 0; p < n_pairs; p++)
+    {
+        size_t c1 = get<0>(class_pairs_[p]);
+        size_t c2 = get<1>(class_pairs_[p]);
+        size_t count = get<2>(class_pairs_[p]);
+        first_stub1[p] = cursor[c1];
+        cursor[c1] += count;
+        first_stub2[p] = cursor[c2];
+        cursor[c2] += count;
+        edge_offset[p+1] = edge_offset[p] + count;
+    }
+
+    EdgeList edge_list(edge_offset.back());
+    vector<RepairStatus> pair_status(n_pairs, RepairStatus::SUCCESS);
+    parallel_for(n_pairs, n_threads, [&](size_t begin, size_t end)
+            {
+                for (size_t p = begin; p < end; p++)
+                {
+                    size_t count = get<2>(class_pairs_[p]);
+                    bool same_class = get<0>(class_pairs_[p]) ==
+                        get<1>(class_pairs_[p]);
+                    //random matching, the 2*count stubs of a single class
+                    //are contiguous
+                    RNGType pair_gen(seed, n_classes + p);
+                    if (same_class)
+                        shuffle(stubs.begin() + first_stub1[p],
+                                stubs.begin() + first_stub1[p] + 2*count,
+                                pair_gen);
                     else
+                        shuffle(stubs.begin() + first_stub2[p],
+                                stubs.begin() + first_stub2[p] + count,
+                                pair_gen);
+                    auto first = edge_list.begin() + edge_offset[p];
+                    for (size_t i = 0; i < count; i++)
                     {
-                        edge_list[edge1].second = node2a;
-                        edge_list[edge2].first = node1b;
+                        first[i].first = stubs[first_stub1[p] + i];
+                        first[i].second = stubs[first_stub2[p] + i];
+                        if (first[i].first > first[i].second)
+                            swap(first[i].first, first[i].second);
                     }
-                    if (edge_list[edge1].first > edge_list[edge1].second)
+                    if (not simple_graph)
                     {
-                        swap(edge_list[edge1].first,edge_list[edge1].second);
+                        continue;
                     }
-                    if (edge_list[edge2].first > edge_list[edge2].second)
+                    //the rewiring exchanges the endpoints of the same
+                    //class, for two classes the edges are (class 1, class 2)
+                    EdgeList pair_edge_list(first, first + count);
+                    if (not same_class)
                     {
-                        swap(edge_list[edge2].first,edge_list[edge2].second);
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            pair_edge_list[i].first =
+                                stubs[first_stub1[p] + i];
+                            pair_edge_list[i].second =
+                                stubs[first_stub2[p] + i];
+                        }
+                    }
+                    pair_status[p] = rewire_faulty_edges(pair_edge_list,
+                            pair_gen, max_rewiring_, max_seconds_,
+                            same_class ? EdgeType::UNDIRECTED :
+                            EdgeType::BIPARTITE);
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        first[i] = pair_edge_list[i];
+                        if (first[i].first > first[i].second)
+                            swap(first[i].first, first[i].second);
                     }
                 }
-            }
-        }
-    }
+            });
 
+    status_ = RepairStatus::SUCCESS;
+    for (RepairStatus status : pair_status)
+    {
+        if (status != RepairStatus::SUCCESS)
+            status_ = status;
+    }
     return edge_list;
 }
 
+//Generates joint degree instance as a CSR adjacency
+template<typename NodeType>
+BasicCSRGraph<NodeType> BasicJointDegreeGenerator<NodeType>::get_graph_csr(
+        bool simple_graph, unsigned int n_threads)
+{
+    return edge_list_to_csr(get_graph(simple_graph, n_threads),
+            degree_sequence_);
+}
+
 /* ========================================
  * Configuration model sampler
  * ======================================== */
 
 //Constructor of configuration model sampler
-ConfigurationModelSampler::ConfigurationModelSampler(
-            const EdgeList& edge_list,
+template<typename NodeType>
+BasicConfigurationModelSampler<NodeType>::BasicConfigurationModelSampler(
+            EdgeList edge_list,
             unsigned int seed, bool simple_graph) :
-    gen_(seed), current_edge_list_(edge_list), simple_graph_(simple_graph),
-    current_edge_set_()
+    simple_graph_(simple_graph), number_of_nodes_(0), gen_(seed),
+    current_edge_list_(move(edge_list)),
+    current_edge_set_(current_edge_list_.size()), stride_(0),
+    track_triangles_(false), current_observables_(), observables_(),
+    degree_sequence_(), degree_product_(0), mean_excess_(0),
+    excess_variance_(0), beta_(0), target_transitivity_(0), triangles_(0),
+    triples_(0), adjacency_()
 {
-    for (int i = 0; i < edge_list.size(); i++)
+    //edge_swap draws a second edge different from the first one
+    bool distinct_edges = false;
+    for (size_t i = 0; i < current_edge_list_.size(); i++)
+    {
+        current_edge_set_.insert(undirected_edge_key(current_edge_list_[i]));
+        number_of_nodes_ = max(number_of_nodes_, size_t(max(
+                        current_edge_list_[i].first,
+                        current_edge_list_[i].second))+1);
+        distinct_edges = distinct_edges or
+            current_edge_list_[i] != current_edge_list_[0];
+    }
+    if (not distinct_edges)
+    {
+        throw invalid_argument(
+                "The edge list must contain at least two distinct edges");
+    }
+    if (not simple_graph_)
     {
-        current_edge_set_.insert(edge_list[i]);
+        current_edge_set_ = EdgeMultiset();
     }
 }
 
-//verify the existance of an edge
-bool ConfigurationModelSampler::exists(const Edge& e) const
+//Constructor of a chain of get_graphs: only the edges (and the adjacency for
+//a target transitivity) are copied, the observables are not tracked
+template<typename NodeType>
+BasicConfigurationModelSampler<NodeType>::BasicConfigurationModelSampler(
+        const BasicConfigurationModelSampler& sampler, RNGType gen) :
+    simple_graph_(sampler.simple_graph_),
+    number_of_nodes_(sampler.number_of_nodes_), gen_(gen),
+    current_edge_list_(sampler.current_edge_list_),
+    current_edge_set_(sampler.current_edge_set_), stride_(0),
+    track_triangles_(false), current_observables_(), observables_(),
+    degree_sequence_(), degree_product_(0), mean_excess_(0),
+    excess_variance_(0), beta_(sampler.beta_),
+    target_transitivity_(sampler.target_transitivity_),
+    triangles_(sampler.triangles_), triples_(sampler.triples_),
+    adjacency_(beta_ > 0 ? sampler.adjacency_ : BasicCSRGraph<Node>())
 {
-    Edge e_copy = e;
-    bool in_edge_set = current_edge_set_.count(e_copy);
-    swap(e_copy.first, e_copy.second);
-    return in_edge_set or current_edge_set_.count(e_copy);
+}
+
+//verify the existance of an edge, in any orientation
+template<typename NodeType>
+bool BasicConfigurationModelSampler<NodeType>::exists(const Edge& e) const
+{
+    return current_edge_set_.count(undirected_edge_key(e)) > 0;
 }
 
 //perform an edge swap
-void ConfigurationModelSampler::edge_swap()
+template<typename NodeType>
+void BasicConfigurationModelSampler<NodeType>::edge_swap()
 {
     //get first edge
     size_t index1 = random_int(current_edge_list_.size(), gen_);
@@ -162,68 +1033,707 @@ void ConfigurationModelSampler::edge_swap()
     //remove from edge list and edge set
     swap(current_edge_list_[index1], current_edge_list_.back());
     current_edge_list_.pop_back();
-    current_edge_set_.erase(e1);
+    if (simple_graph_)
+        current_edge_set_.erase(undirected_edge_key(e1));
+
+    //get a second edge
+    size_t index2 = random_int(current_edge_list_.size(), gen_);
+    Edge e2 = current_edge_list_[index2];
+
+    //resample e2 if same edge
+    while(e2 == e1)
+    {
+        index2 = random_int(current_edge_list_.size(), gen_);
+        e2 = current_edge_list_[index2];
+    }
+
+    //remove from the edge list and edge set
+    swap(current_edge_list_[index2], current_edge_list_.back());
+    current_edge_list_.pop_back();
+    if (simple_graph_)
+        current_edge_set_.erase(undirected_edge_key(e2));
+
+    //choose between two possible types of swap
+    Edge old_e1 = e1;
+    Edge old_e2 = e2;
+    int choice = random_int(2, gen_);
+    if(choice)
+    {
+        swap(e2.second, e1.second);
+    }
+    else
+    {
+        swap(e2.second, e1.first);
+    }
+
+    //verify if the new graph is simple graph
+    bool accepted = true;
+    if(simple_graph_)
+    {
+        bool self_loop = e1.first == e1.second or e2.first == e2.second;
+        if(self_loop or exists(e1) or exists(e2))
+        {
+            accepted = false;
+            if (self_loop)
+                current_observables_.rejected_self_loops += 1;
+            else
+                current_observables_.rejected_multiedges += 1;
+            //the swap makes the graph exit the graph space : swap back
+            if(choice)
+            {
+                swap(e2.second, e1.second);
+            }
+            else
+            {
+                swap(e2.second, e1.first);
+            }
+        }
+    }
+
+    //Metropolis rule on the distance to the target transitivity
+    if (accepted and (track_triangles_ or beta_ > 0))
+    {
+        size_t triangles = move_triangles(old_e1, old_e2, e1, e2);
+        double delta = fabs(3*triangles/triples_ - target_transitivity_) -
+            fabs(3*triangles_/triples_ - target_transitivity_);
+        if (beta_ > 0 and delta > 0 and random_01(gen_) >= exp(-beta_*delta))
+        {
+            accepted = false;
+            current_observables_.rejected_metropolis += 1;
+            move_triangles(e1, e2, old_e1, old_e2);
+            e1 = old_e1;
+            e2 = old_e2;
+        }
+        else
+        {
+            triangles_ = triangles;
+        }
+    }
+
+    //insert the new edges
+    if (simple_graph_)
+    {
+        current_edge_set_.insert(undirected_edge_key(e1));
+        current_edge_set_.insert(undirected_edge_key(e2));
+    }
+    current_edge_list_.push_back(e1);
+    current_edge_list_.push_back(e2);
+    if (stride_)
+        record_swap(old_e1, old_e2, e1, e2, accepted);
+}
+
+//start recording the observables every stride edge swaps, from the current
+//graph; the series of the previous tracking is discarded
+template<typename NodeType>
+void BasicConfigurationModelSampler<NodeType>::track_observables(
+        size_t stride, bool triangles)
+{
+    if (triangles and not simple_graph_)
+    {
+        throw invalid_argument(
+                "The triangles are only tracked for simple graphs");
+    }
+    if (triangles and number_of_nodes_ > numeric_limits<Node>::max())
+    {
+        throw invalid_argument(
+                "The largest node index is reserved to track triangles");
+    }
+    stride_ = stride;
+    track_triangles_ = triangles and stride > 0;
+    current_observables_ = SamplerObservables();
+    observables_.clear();
+    init_triangles();
+    if (stride_)
+    {
+        init_observables();
+    }
+    else
+    {
+        vector<unsigned int>().swap(degree_sequence_);
+    }
+}
+
+//Metropolis sampling of simple graphs with a weight exp(-beta |t - target|),
+//where t is the transitivity; beta = 0 restores the uniform sampling
+template<typename NodeType>
+void BasicConfigurationModelSampler<NodeType>::set_target_transitivity(
+        double transitivity, double beta)
+{
+    if (beta > 0 and not simple_graph_)
+    {
+        throw invalid_argument(
+                "The transitivity is only targeted for simple graphs");
+    }
+    if (beta > 0 and number_of_nodes_ > numeric_limits<Node>::max())
+    {
+        throw invalid_argument(
+                "The largest node index is reserved to track triangles");
+    }
+    if (beta < 0 or transitivity < 0 or transitivity > 1)
+    {
+        throw invalid_argument("beta must be positive and the transitivity "
+                "between 0 and 1");
+    }
+    bool kept = track_triangles_ or beta_ > 0;
+    target_transitivity_ = transitivity;
+    beta_ = beta;
+    if (kept != (track_triangles_ or beta_ > 0))
+        init_triangles();
+}
+
+//transitivity of the current graph, when the triangles are kept
+template<typename NodeType>
+double BasicConfigurationModelSampler<NodeType>::transitivity() const
+{
+    if (not (track_triangles_ or beta_ > 0))
+        return numeric_limits<double>::quiet_NaN();
+    return 3*triangles_/triples_;
+}
+
+//compute the observables of the current graph from scratch
+template<typename NodeType>
+void BasicConfigurationModelSampler<NodeType>::init_observables()
+{
+    degree_sequence_.assign(number_of_nodes_, 0);
+    for (auto& edge : current_edge_list_)
+    {
+        degree_sequence_[edge.first] += 1;
+        degree_sequence_[edge.second] += 1;
+    }
+    //the excess degrees of the edge ends have fixed mean and variance
+    double E = current_edge_list_.size();
+    double sum_square = 0;
+    double sum_cube = 0;
+    for (double k : degree_sequence_)
+    {
+        sum_square += k*k;
+        sum_cube += k*k*k;
+    }
+    mean_excess_ = sum_square/(2*E);
+    excess_variance_ = sum_cube/(2*E) - mean_excess_*mean_excess_;
+    degree_product_ = 0;
+    for (auto& edge : current_edge_list_)
+    {
+        degree_product_ += double(degree_sequence_[edge.first])*
+            degree_sequence_[edge.second];
+    }
+    current_observables_.assortativity = (degree_product_/E -
+            mean_excess_*mean_excess_)/excess_variance_;
+    current_observables_.triangles = track_triangles_ ? triangles_ : 0;
+}
+
+//sorted neighbors and number of triangles of the current graph, only kept
+//when the triangles are tracked or targeted
+template<typename NodeType>
+void BasicConfigurationModelSampler<NodeType>::init_triangles()
+{
+    triangles_ = 0;
+    triples_ = 0;
+    if (not (track_triangles_ or beta_ > 0))
+    {
+        adjacency_ = BasicCSRGraph<Node>();
+        return;
+    }
+    adjacency_ = edge_list_to_csr(current_edge_list_, number_of_nodes_);
+    for (size_t i = 0; i < number_of_nodes_; i++)
+    {
+        sort(adjacency_.indices.begin() + adjacency_.indptr[i],
+                adjacency_.indices.begin() + adjacency_.indptr[i+1]);
+        double k = adjacency_.indptr[i+1] - adjacency_.indptr[i];
+        triples_ += k*(k-1)/2;
+    }
+    size_t corners = 0;
+    for (auto& edge : current_edge_list_)
+    {
+        corners += common_neighbors(edge.first, edge.second);
+    }
+    triangles_ = corners/3;
+}
+
+//apply the swap of e1 and e2 into f1 and f2 to the sorted neighbors and
+//return the new number of triangles; the old edges are removed one at a
+//time, then the new ones are added
+template<typename NodeType>
+size_t BasicConfigurationModelSampler<NodeType>::move_triangles(
+        const Edge& e1, const Edge& e2, const Edge& f1, const Edge& f2)
+{
+    const Node none = numeric_limits<Node>::max();
+    size_t triangles = triangles_;
+    for (const Edge* e : {&e1, &e2})
+    {
+        triangles -= common_neighbors(e->first, e->second);
+        replace_neighbor(e->first, e->second, none);
+        replace_neighbor(e->second, e->first, none);
+    }
+    for (const Edge* f : {&f1, &f2})
+    {
+        replace_neighbor(f->first, none, f->second);
+        replace_neighbor(f->second, none, f->first);
+        triangles += common_neighbors(f->first, f->second);
+    }
+    return triangles;
+}
+
+//number of common neighbors of u and v, the removed neighbors are marked
+//with the largest node index and sorted last
+template<typename NodeType>
+size_t BasicConfigurationModelSampler<NodeType>::common_neighbors(Node u,
+        Node v) const
+{
+    const Node none = numeric_limits<Node>::max();
+    const Node* u_first = adjacency_.indices.data() + adjacency_.indptr[u];
+    const Node* u_last = adjacency_.indices.data() + adjacency_.indptr[u+1];
+    const Node* v_first = adjacency_.indices.data() + adjacency_.indptr[v];
+    const Node* v_last = adjacency_.indices.data() + adjacency_.indptr[v+1];
+    size_t count = 0;
+    while (u_first != u_last and v_first != v_last and *u_first != none and
+            *v_first != none)
+    {
+        if (*u_first < *v_first)
+            ++u_first;
+        else if (*v_first < *u_first)
+            ++v_first;
+        else
+        {
+            count += 1;
+            ++u_first;
+            ++v_first;
+        }
+    }
+    return count;
+}
+
+//replace old_neighbor by new_neighbor in the sorted neighbors of w
+template<typename NodeType>
+void BasicConfigurationModelSampler<NodeType>::replace_neighbor(Node w,
+        Node old_neighbor, Node new_neighbor)
+{
+    Node* first = adjacency_.indices.data() + adjacency_.indptr[w];
+    Node* last = adjacency_.indices.data() + adjacency_.indptr[w+1];
+    Node* position = lower_bound(first, last, old_neighbor);
+    Node* target = lower_bound(first, last, new_neighbor);
+    if (target > position)
+    {
+        move(position+1, target, position);
+        *(target-1) = new_neighbor;
+    }
+    else
+    {
+        move_backward(target, position, position+1);
+        *target = new_neighbor;
+    }
+}
+
+//update the observables after a swap of e1 and e2 into f1 and f2
+template<typename NodeType>
+void BasicConfigurationModelSampler<NodeType>::record_swap(const Edge& e1,
+        const Edge& e2, const Edge& f1, const Edge& f2, bool accepted)
+{
+    current_observables_.swaps += 1;
+    if (accepted)
+    {
+        current_observables_.accepted += 1;
+        const vector<unsigned int>& k = degree_sequence_;
+        degree_product_ += double(k[f1.first])*k[f1.second] +
+            double(k[f2.first])*k[f2.second] -
+            double(k[e1.first])*k[e1.second] -
+            double(k[e2.first])*k[e2.second];
+    }
+    if (current_observables_.swaps % stride_ == 0)
+    {
+        double E = current_edge_list_.size();
+        current_observables_.assortativity = (degree_product_/E -
+                mean_excess_*mean_excess_)/excess_variance_;
+        current_observables_.triangles = track_triangles_ ? triangles_ : 0;
+        observables_.push_back(current_observables_);
+    }
+}
+
+//return the current edge list after a certain mixing time
+template<typename NodeType>
+BasicEdgeList<NodeType>
+    BasicConfigurationModelSampler<NodeType>::get_graph(unsigned int step)
+{
+    for (unsigned int i = 0; i < step; i++)
+    {
+        edge_swap();
+    }
+    return current_edge_list_;
+}
+
+//Samples of the chain taken every step edge swaps, each handed to the sink
+//without copy; the sink must copy the edges it keeps
+template<typename NodeType>
+void BasicConfigurationModelSampler<NodeType>::samples(size_t n,
+        unsigned int step,
+        const function<void(size_t,const EdgeList&)>& sink)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        for (unsigned int s = 0; s < step; s++)
+        {
+            edge_swap();
+        }
+        sink(i, current_edge_list_);
+    }
+}
+
+//Runs k independent chains of step edge swaps in parallel, all starting from
+//the current edge list, which is left unchanged. The chain i uses the stream
+//i of an RNG seeded from gen_ and works on its own copy of the edges and of
+//the edge set, made by the thread running it when the chain starts, so the
+//result does not depend on n_threads. The observables and the triangle
+//adjacency (unless a transitivity is targeted) are not copied.
+template<typename NodeType>
+pair<BasicEdgeList<NodeType>,vector<size_t>>
+    BasicConfigurationModelSampler<NodeType>::get_graphs(size_t k,
+        unsigned int step, unsigned int n_threads)
+{
+    uint64_t seed = draw_seed(gen_);
+    vector<EdgeList> edge_list_vector(k);
+    parallel_for(k, n_threads, [&](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; i++)
+                {
+                    BasicConfigurationModelSampler chain(*this,
+                            RNGType(seed, i));
+                    for (unsigned int s = 0; s < step; s++)
+                    {
+                        chain.edge_swap();
+                    }
+                    edge_list_vector[i] = move(chain.current_edge_list_);
+                }
+            });
+    return concatenate(edge_list_vector);
+}
+
+//return the current edge list after step edge swaps shared among n_threads
+//workers. A worker claims the two edges of its swap, and for simple graphs
+//also locks the shards of the edge set holding the removed and added edges,
+//so each swap is applied atomically as in the serial chain. The sample only
+//depends on the seed for n_threads = 1.
+template<typename NodeType>
+BasicEdgeList<NodeType>
+    BasicConfigurationModelSampler<NodeType>::get_graph_parallel(size_t step,
+        unsigned int n_threads)
+{
+    typedef typename EdgeKey<Node>::type Key;
+    if (beta_ > 0)
+    {
+        throw invalid_argument(
+                "The parallel edge swaps do not target a transitivity");
+    }
+    const size_t n_edges = current_edge_list_.size();
+    //keep free edges available to every worker
+    n_threads = min(thread_count(n_threads),
+            unsigned(max(n_edges/4, size_t(1))));
+
+    //edge set split in shards, each with its own lock
+    unsigned int shard_shift = 0;
+    while ((size_t(1) << shard_shift) < 64*size_t(n_threads))
+    {
+        shard_shift += 1;
+    }
+    const size_t n_shards = size_t(1) << shard_shift;
+    auto shard_of = [shard_shift](Key key)
+        {
+            return shard_shift == 0 ? size_t(0) : size_t(
+                    (fold_key(key)*0xC2B2AE3D27D4EB4FULL) >> (64-shard_shift));
+        };
+    vector<EdgeMultiset> shards;
+    vector<mutex> shard_mutex(n_shards);
+    if (simple_graph_)
+    {
+        shards.assign(n_shards, EdgeMultiset(2*n_edges/n_shards));
+        for (const Edge& edge : current_edge_list_)
+        {
+            Key key = undirected_edge_key(edge);
+            shards[shard_of(key)].insert(key);
+        }
+    }
+    vector<atomic<bool>> claimed(n_edges);
+
+    uint64_t seed = draw_seed(gen_);
+    parallel_for(n_threads, n_threads, [&](size_t begin, size_t end)
+            {
+                for (size_t t = begin; t < end; t++)
+                {
+                    RNGType gen(seed, t);
+                    size_t n_steps = step*(t+1)/n_threads -
+                        step*t/n_threads;
+                    for (size_t s = 0; s < n_steps; s++)
+                    {
+                        //claim a first edge
+                        size_t index1 = random_int(n_edges, gen);
+                        while (claimed[index1].exchange(true,
+                                    memory_order_acquire))
+                        {
+                            index1 = random_int(n_edges, gen);
+                        }
+                        Edge e1 = current_edge_list_[index1];
+
+                        //claim a second edge, different from the first one
+                        size_t index2;
+                        Edge e2;
+                        while (true)
+                        {
+                            index2 = random_int(n_edges, gen);
+                            if (index2 == index1 or claimed[index2].exchange(
+                                        true, memory_order_acquire))
+                                continue;
+                            e2 = current_edge_list_[index2];
+                            if (e2 != e1)
+                                break;
+                            claimed[index2].store(false,
+                                    memory_order_release);
+                        }
+
+                        //choose between two possible types of swap
+                        Edge f1 = e1;
+                        Edge f2 = e2;
+                        if (random_int(2, gen))
+                            swap(f2.second, f1.second);
+                        else
+                            swap(f2.second, f1.first);
+
+                        //verify if the new graph is simple graph
+                        bool accepted = true;
+                        if (simple_graph_)
+                        {
+                            accepted = f1.first != f1.second and
+                                f2.first != f2.second;
+                        }
+                        if (simple_graph_ and accepted)
+                        {
+                            Key keys[4] = {undirected_edge_key(e1),
+                                undirected_edge_key(e2),
+                                undirected_edge_key(f1),
+                                undirected_edge_key(f2)};
+                            size_t locked[4];
+                            for (int i = 0; i < 4; i++)
+                            {
+                                locked[i] = shard_of(keys[i]);
+                            }
+                            //always lock in increasing order
+                            sort(locked, locked+4);
+                            size_t* locked_end = unique(locked, locked+4);
+                            for (size_t* l = locked; l != locked_end; l++)
+                            {
+                                shard_mutex[*l].lock();
+                            }
+                            shards[shard_of(keys[0])].erase(keys[0]);
+                            shards[shard_of(keys[1])].erase(keys[1]);
+                            accepted =
+                                shards[shard_of(keys[2])].count(keys[2]) == 0
+                                and shards[shard_of(keys[3])].count(keys[3])
+                                == 0;
+                            int first_key = accepted ? 2 : 0;
+                            shards[shard_of(keys[first_key])].insert(
+                                    keys[first_key]);
+                            shards[shard_of(keys[first_key+1])].insert(
+                                    keys[first_key+1]);
+                            for (size_t* l = locked_end; l != locked; l--)
+                            {
+                                shard_mutex[*(l-1)].unlock();
+                            }
+                        }
+                        if (accepted)
+                        {
+                            current_edge_list_[index1] = f1;
+                            current_edge_list_[index2] = f2;
+                        }
+                        claimed[index2].store(false, memory_order_release);
+                        claimed[index1].store(false, memory_order_release);
+                    }
+                }
+            });
+
+    //the edge set of the serial chain follows the new edge list
+    if (simple_graph_)
+    {
+        current_edge_set_ = EdgeMultiset(n_edges);
+        for (const Edge& edge : current_edge_list_)
+        {
+            current_edge_set_.insert(undirected_edge_key(edge));
+        }
+    }
+    //the tracked observables restart from the new graph, the parallel swaps
+    //are not recorded
+    init_triangles();
+    if (stride_)
+    {
+        init_observables();
+    }
+    return current_edge_list_;
+}
+
+/* ========================================
+ * Curveball sampler
+ * ======================================== */
+
+//Constructor of curveball sampler, the edge list must be a simple graph
+template<typename NodeType>
+BasicCurveballSampler<NodeType>::BasicCurveballSampler(
+        const EdgeList& edge_list, unsigned int seed) :
+    gen_(seed), adjacency_(), node_vector_(), common_(), only_u_(), only_v_(),
+    traded_()
+{
+    size_t number_of_nodes = 0;
+    for (auto& edge : edge_list)
+    {
+        if (edge.first == edge.second)
+            throw invalid_argument("The edge list contains self-loops");
+        number_of_nodes = max(number_of_nodes,
+                size_t(max(edge.first, edge.second))+1);
+    }
+    adjacency_ = edge_list_to_csr(edge_list, number_of_nodes);
+    for (size_t i = 0; i < number_of_nodes; i++)
+    {
+        auto first = adjacency_.indices.begin() + adjacency_.indptr[i];
+        auto last = adjacency_.indices.begin() + adjacency_.indptr[i+1];
+        sort(first, last);
+        if (adjacent_find(first, last) != last)
+            throw invalid_argument("The edge list contains multiedges");
+    }
+    node_vector_.resize(number_of_nodes);
+    iota(node_vector_.begin(), node_vector_.end(), Node(0));
+}
+
+//replace old_neighbor by new_neighbor in the sorted neighbors of w
+template<typename NodeType>
+void BasicCurveballSampler<NodeType>::replace_neighbor(Node w,
+        Node old_neighbor, Node new_neighbor)
+{
+    Node* first = adjacency_.indices.data() + adjacency_.indptr[w];
+    Node* last = adjacency_.indices.data() + adjacency_.indptr[w+1];
+    Node* position = lower_bound(first, last, old_neighbor);
+    Node* target = lower_bound(first, last, new_neighbor);
+    if (target > position)
+    {
+        move(position+1, target, position);
+        *(target-1) = new_neighbor;
+    }
+    else
+    {
+        move_backward(target, position, position+1);
+        *target = new_neighbor;
+    }
+}
 
-    //get a second edge
-    size_t index2 = random_int(current_edge_list_.size(), gen_);
-    Edge e2 = current_edge_list_[index2];
+//trade the neighbors that only one of u and v has
+template<typename NodeType>
+void BasicCurveballSampler<NodeType>::trade(Node u, Node v)
+{
+    Node* u_first = adjacency_.indices.data() + adjacency_.indptr[u];
+    Node* u_last = adjacency_.indices.data() + adjacency_.indptr[u+1];
+    Node* v_first = adjacency_.indices.data() + adjacency_.indptr[v];
+    Node* v_last = adjacency_.indices.data() + adjacency_.indptr[v+1];
 
-    //resample e2 if same edge
-    while(e2 == e1)
+    //split the neighbors with linear merges, u and v are never traded
+    common_.clear();
+    only_u_.clear();
+    only_v_.clear();
+    set_intersection(u_first, u_last, v_first, v_last,
+            back_inserter(common_));
+    set_difference(u_first, u_last, v_first, v_last, back_inserter(only_u_));
+    set_difference(v_first, v_last, u_first, u_last, back_inserter(only_v_));
+    bool adjacent = binary_search(u_first, u_last, v);
+    if (adjacent)
     {
-        index2 = random_int(current_edge_list_.size(), gen_);
-        e2 = current_edge_list_[index2];
+        only_u_.erase(lower_bound(only_u_.begin(), only_u_.end(), v));
+        only_v_.erase(lower_bound(only_v_.begin(), only_v_.end(), u));
     }
+    if (only_u_.empty() or only_v_.empty())
+        return;
 
-    //remove from the edge list and edge set
-    swap(current_edge_list_[index2], current_edge_list_.back());
-    current_edge_list_.pop_back();
-    current_edge_set_.erase(e2);
+    //deal the shuffled neighbors back, u keeps its degree
+    traded_.clear();
+    traded_.insert(traded_.end(), only_u_.begin(), only_u_.end());
+    traded_.insert(traded_.end(), only_v_.begin(), only_v_.end());
+    shuffle(traded_.begin(), traded_.end(), gen_);
+    auto middle = traded_.begin() + only_u_.size();
+    sort(traded_.begin(), middle);
+    sort(middle, traded_.end());
 
-    //choose between two possible types of swap
-    int choice = random_int(2, gen_);
-    if(choice)
+    //the neighbors that changed side point to their new neighbor
+    for (auto it = traded_.begin(); it != middle; ++it)
     {
-        swap(e2.second, e1.second);
+        if (not binary_search(only_u_.begin(), only_u_.end(), *it))
+            replace_neighbor(*it, v, u);
     }
-    else
+    for (auto it = middle; it != traded_.end(); ++it)
     {
-        swap(e2.second, e1.first);
+        if (not binary_search(only_v_.begin(), only_v_.end(), *it))
+            replace_neighbor(*it, u, v);
     }
 
-    //verify if the new graph is simple graph
-    if(simple_graph_)
+    //write the new sorted neighbors of u and v
+    if (adjacent)
+    {
+        common_.insert(lower_bound(common_.begin(), common_.end(), v), v);
+    }
+    merge(common_.begin(), common_.end(), traded_.begin(), middle, u_first);
+    if (adjacent)
+    {
+        common_.erase(lower_bound(common_.begin(), common_.end(), v));
+        common_.insert(lower_bound(common_.begin(), common_.end(), u), u);
+    }
+    merge(common_.begin(), common_.end(), middle, traded_.end(), v_first);
+}
+
+//edge list of the current graph, each edge appears once with i < j
+template<typename NodeType>
+BasicEdgeList<NodeType> BasicCurveballSampler<NodeType>::edge_list() const
+{
+    EdgeList edge_list;
+    edge_list.reserve(adjacency_.indices.size()/2);
+    for (size_t i = 0; i < number_of_nodes(); i++)
     {
-        if(e1.first == e1.second or e2.first == e2.second or
-                exists(e1) or exists(e2))
+        for (size_t p = adjacency_.indptr[i]; p < adjacency_.indptr[i+1];
+                p++)
         {
-            //the swap makes the graph exit the graph space : swap back
-            if(choice)
-            {
-                swap(e2.second, e1.second);
-            }
-            else
-            {
-                swap(e2.second, e1.first);
-            }
+            if (i < adjacency_.indices[p])
+                edge_list.emplace_back(i, adjacency_.indices[p]);
         }
     }
+    return edge_list;
+}
 
-    //insert the new edges
-    current_edge_set_.insert(e1);
-    current_edge_set_.insert(e2);
-    current_edge_list_.push_back(e1);
-    current_edge_list_.push_back(e2);
+//return the edge list after step trades between random pairs of nodes
+template<typename NodeType>
+BasicEdgeList<NodeType>
+    BasicCurveballSampler<NodeType>::get_graph(unsigned int step)
+{
+    size_t N = number_of_nodes();
+    if (N >= 2)
+    {
+        for (unsigned int i = 0; i < step; i++)
+        {
+            Node u = random_int(N, gen_);
+            Node v = random_int(N-1, gen_);
+            if (v >= u)
+                v += 1;
+            trade(u, v);
+        }
+    }
+    return edge_list();
 }
 
-//return the current edge list after a certain mixing time
-EdgeList ConfigurationModelSampler::get_graph(unsigned int step)
+//return the edge list after step global trades, each pairing all the nodes
+//with a random permutation
+template<typename NodeType>
+BasicEdgeList<NodeType>
+    BasicCurveballSampler<NodeType>::get_graph_global(unsigned int step)
 {
-    for (int i = 0; i < step; i++)
+    for (unsigned int i = 0; i < step; i++)
     {
-        edge_swap();
+        shuffle(node_vector_.begin(), node_vector_.end(), gen_);
+        for (size_t j = 0; j + 1 < node_vector_.size(); j += 2)
+        {
+            trade(node_vector_[j], node_vector_[j+1]);
+        }
     }
-    return current_edge_list_;
+    return edge_list();
 }
 
 /* ========================================
@@ -231,38 +1741,28 @@ EdgeList ConfigurationModelSampler::get_graph(unsigned int step)
  * ======================================== */
 
 //Constructor of clustered graph generator
-ClusteredGraphGenerator::ClusteredGraphGenerator(
-        const vector<unsigned int>& membership_sequence,
-        const vector<unsigned int>& clique_size_sequence,
+template<typename NodeType>
+BasicClusteredGraphGenerator<NodeType>::BasicClusteredGraphGenerator(
+        vector<unsigned int> membership_sequence,
+        vector<unsigned int> clique_size_sequence,
         unsigned int seed) :
-    gen_(seed), membership_sequence_(membership_sequence),
-    clique_size_sequence_(clique_size_sequence), clique_stub_vector_(),
+    seed_(seed), gen_(seed), membership_sequence_(move(membership_sequence)),
+    clique_size_sequence_(move(clique_size_sequence)), clique_stub_vector_(),
     node_stub_vector_()
 {
     try
     {
-        if (accumulate(clique_size_sequence.begin(), clique_size_sequence.end(),
-                    0) != accumulate(membership_sequence.begin(),
-                    membership_sequence.end(), 0))
+        if (accumulate(clique_size_sequence_.begin(),
+                    clique_size_sequence_.end(), size_t(0)) != accumulate(
+                    membership_sequence_.begin(), membership_sequence_.end(),
+                    size_t(0)))
         {
             throw invalid_argument(
                     "Membership and clique size sequence do not match");
         }
         //initialize clique and node stub vector
-        for (Node i = 0; i < membership_sequence_.size(); i++)
-        {
-            for (int j = 0; j < membership_sequence_[i]; j++)
-            {
-                node_stub_vector_.push_back(i);
-            }
-        }
-        for (unsigned int i = 0; i < clique_size_sequence_.size(); i++)
-        {
-            for (int j = 0; j < clique_size_sequence_[i]; j++)
-            {
-                clique_stub_vector_.push_back(i);
-            }
-        }
+        node_stub_vector_ = stub_vector<Node>(membership_sequence_);
+        clique_stub_vector_ = stub_vector<Node>(clique_size_sequence_);
     }
     catch (invalid_argument& e)
     {
@@ -271,195 +1771,583 @@ ClusteredGraphGenerator::ClusteredGraphGenerator(
 }
 
 //get a clustered graph realization
-pair<EdgeList,vector<set<Node>>> ClusteredGraphGenerator::get_graph()
+template<typename NodeType>
+pair<BasicEdgeList<NodeType>,vector<set<NodeType>>>
+    BasicClusteredGraphGenerator<NodeType>::get_graph(bool sorted_output,
+        unsigned int n_threads)
 {
-    //shuffle the stub vectors
-    shuffle(clique_stub_vector_.begin(),clique_stub_vector_.end(),gen_);
-    shuffle(node_stub_vector_.begin(),node_stub_vector_.end(),gen_);
+    pair<EdgeList,CliqueMembership> graph = get_graph_flat(sorted_output,
+            n_threads);
+    return make_pair(move(graph.first), clique_sets(graph.second));
+}
 
-    //initialize clique sets
-    vector<set<Node>> clique_vector(clique_size_sequence_.size());
+//get a clustered graph realization with flat clique membership
+template<typename NodeType>
+pair<BasicEdgeList<NodeType>,BasicCliqueMembership<NodeType>>
+    BasicClusteredGraphGenerator<NodeType>::get_graph_flat(
+        bool sorted_output, unsigned int n_threads)
+{
+    return sample_graph(gen_, clique_stub_vector_, node_stub_vector_,
+            sorted_output, n_threads);
+}
 
-    //define the edge set and try the matching process
-    EdgeSet edge_set;
+//get k clustered graph realizations in parallel, the realization i uses the
+//stream i of the RNG seeded with seed_
+template<typename NodeType>
+pair<BasicEdgeList<NodeType>,vector<size_t>>
+    BasicClusteredGraphGenerator<NodeType>::get_graphs(size_t k,
+        unsigned int n_threads) const
+{
+    vector<EdgeList> edge_list_vector(k);
+    parallel_for(k, n_threads, [&](size_t begin, size_t end)
+            {
+                //each realization starts from the unshuffled stub vectors
+                const vector<Node> clique_stubs = stub_vector<Node>(
+                        clique_size_sequence_);
+                const vector<Node> node_stubs = stub_vector<Node>(
+                        membership_sequence_);
+                vector<Node> clique_stub_vector;
+                vector<Node> node_stub_vector;
+                for (size_t i = begin; i < end; i++)
+                {
+                    RNGType gen(seed_, i);
+                    clique_stub_vector = clique_stubs;
+                    node_stub_vector = node_stubs;
+                    edge_list_vector[i] = sample_graph(gen,
+                            clique_stub_vector, node_stub_vector, true,
+                            1).first;
+                }
+            });
+    return concatenate(edge_list_vector);
+}
 
-    //insert members in cliques
-    for (size_t i = 0; i < clique_stub_vector_.size(); i++)
+//get a clustered graph realization with a given RNG and stub vectors. The
+//pairs of each clique are written as packed keys in a flat array, then the
+//pairs joined by several cliques are removed with a radix sort, or with a
+//hash set keeping the first occurrences if sorted_output is false.
+template<typename NodeType>
+pair<BasicEdgeList<NodeType>,BasicCliqueMembership<NodeType>>
+    BasicClusteredGraphGenerator<NodeType>::sample_graph(
+        RNGType& gen, vector<NodeType>& clique_stub_vector,
+        vector<Node>& node_stub_vector, bool sorted_output,
+        unsigned int n_threads) const
+{
+    typedef typename EdgeKey<Node>::type Key;
+
+    //shuffle the stub vectors
+    shuffle(clique_stub_vector.begin(),clique_stub_vector.end(),gen);
+    shuffle(node_stub_vector.begin(),node_stub_vector.end(),gen);
+
+    //insert members in cliques, each member appears once in sorted order
+    CliqueMembership membership = clique_membership(clique_size_sequence_,
+            clique_stub_vector, node_stub_vector);
+    remove_repeated_members(membership);
+
+    //position of the first pair of each clique
+    size_t n_cliques = clique_size_sequence_.size();
+    vector<size_t> pair_offsets(n_cliques+1, 0);
+    for (size_t c = 0; c < n_cliques; c++)
     {
-        clique_vector[clique_stub_vector_[i]].insert(
-                node_stub_vector_[i]);
+        size_t k = membership.offsets[c+1] - membership.offsets[c];
+        pair_offsets[c+1] = pair_offsets[c] + k*(k-1)/2;
     }
 
-    //For each clique, get the edges
-    for (auto& clique : clique_vector)
-    {
-        auto iter1 = clique.begin();
-        auto iter2 = clique.begin();
-        for (; iter1 != clique.end(); iter1++)
-        {
-            iter2 = iter1;
-            iter2++;
-            for (; iter2 != clique.end(); iter2++)
+    //For each clique, get the edges (smaller node label first)
+    vector<Key> keys(pair_offsets.back());
+    parallel_for(n_cliques, n_threads, [&](size_t begin, size_t end)
             {
-                //smaller node label first
-                if (*iter1 < *iter2)
-                {
-                    edge_set.emplace(*iter1,*iter2);
-                }
-                if (*iter1 > *iter2)
+                for (size_t c = begin; c < end; c++)
                 {
-                    edge_set.emplace(*iter2,*iter1);
+                    size_t position = pair_offsets[c];
+                    for (size_t i = membership.offsets[c];
+                            i < membership.offsets[c+1]; i++)
+                    {
+                        for (size_t j = i+1; j < membership.offsets[c+1]; j++)
+                        {
+                            keys[position++] = edge_key(BasicEdge<Node>(
+                                        membership.members[i],
+                                        membership.members[j]));
+                        }
+                    }
                 }
-                //if the same label, the edge is not created
-            }
+            });
+
+    //remove the repeated edges
+    if (sorted_output)
+    {
+        parallel_radix_sort(keys, n_threads);
+        keys.erase(unique(keys.begin(), keys.end()), keys.end());
+    }
+    else
+    {
+        BasicEdgeMultiset<Key> edge_set(keys.size());
+        size_t size = 0;
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            if (edge_set.insert(keys[i]) == 1)
+                keys[size++] = keys[i];
         }
+        keys.resize(size);
     }
 
-    return make_pair(EdgeList(edge_set.begin(), edge_set.end()),
-            clique_vector);
+    EdgeList edge_list(keys.size());
+    parallel_for(keys.size(), n_threads, [&](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; i++)
+                {
+                    edge_list[i] = key_edge<Node>(keys[i]);
+                }
+            });
+    return make_pair(move(edge_list), move(membership));
 }
 
 //get a clustered multigraph realization
-pair<EdgeList,vector<vector<Node>>> ClusteredGraphGenerator::get_multigraph()
+template<typename NodeType>
+pair<BasicEdgeList<NodeType>,vector<vector<NodeType>>>
+    BasicClusteredGraphGenerator<NodeType>::get_multigraph()
+{
+    pair<EdgeList,CliqueMembership> graph = get_multigraph_flat();
+    return make_pair(move(graph.first), clique_vectors(graph.second));
+}
+
+//get a clustered multigraph realization with flat clique membership
+template<typename NodeType>
+pair<BasicEdgeList<NodeType>,BasicCliqueMembership<NodeType>>
+    BasicClusteredGraphGenerator<NodeType>::get_multigraph_flat()
 {
     //shuffle the stub vectors
     shuffle(clique_stub_vector_.begin(),clique_stub_vector_.end(),gen_);
     shuffle(node_stub_vector_.begin(),node_stub_vector_.end(),gen_);
 
-    //initialize clique sets
-    vector<vector<Node>> clique_vector(clique_size_sequence_.size());
+    //insert members in cliques
+    CliqueMembership membership = clique_membership(clique_size_sequence_,
+            clique_stub_vector_, node_stub_vector_);
 
     //define the edge list and try the matching process
     EdgeList edge_list;
 
-    //insert members in cliques
-    for (size_t i = 0; i < clique_stub_vector_.size(); i++)
-    {
-        clique_vector[clique_stub_vector_[i]].push_back(
-                node_stub_vector_[i]);
-    }
-
     //For each clique, get the edges
-    for (auto& clique : clique_vector)
+    for (size_t c = 0; c < clique_size_sequence_.size(); c++)
     {
-        auto iter1 = clique.begin();
-        auto iter2 = clique.begin();
-        for (; iter1 != clique.end(); iter1++)
+        for (size_t i = membership.offsets[c]; i < membership.offsets[c+1];
+                i++)
         {
-            iter2 = iter1;
-            iter2++;
-            for (; iter2 != clique.end(); iter2++)
+            for (size_t j = i+1; j < membership.offsets[c+1]; j++)
             {
+                Node node1 = membership.members[i];
+                Node node2 = membership.members[j];
                 //smaller node label first
-                if (*iter1 <= *iter2)
+                if (node1 <= node2)
                 {
-                    edge_list.emplace_back(*iter1,*iter2);
+                    edge_list.emplace_back(node1,node2);
                 }
                 else
                 {
-                    edge_list.emplace_back(*iter2,*iter1);
+                    edge_list.emplace_back(node2,node1);
                 }
-                //if the same label, the edge is not created
             }
         }
     }
 
-    return make_pair(edge_list,clique_vector);
+    return make_pair(move(edge_list),move(membership));
 }
 
 
 //get a clustered multigraph realization
-pair<EdgeTriplet,vector<vector<Node>>> ClusteredGraphGenerator::get_multigraph_2()
+template<typename NodeType>
+pair<BasicEdgeTriplet<NodeType>,vector<vector<NodeType>>>
+    BasicClusteredGraphGenerator<NodeType>::get_multigraph_2(
+        unsigned int n_threads)
+{
+    pair<EdgeTriplet,CliqueMembership> graph = get_multigraph_2_flat(
+            n_threads);
+    return make_pair(move(graph.first), clique_vectors(graph.second));
+}
+
+//sorted packed keys of the pairs of each clique for a new clustered
+//multigraph realization, whose flat clique membership is returned
+template<typename NodeType>
+BasicCliqueMembership<NodeType>
+    BasicClusteredGraphGenerator<NodeType>::multigraph_2_keys(
+        vector<typename EdgeKey<Node>::type>& keys, unsigned int n_threads)
 {
     //shuffle the stub vectors
     shuffle(clique_stub_vector_.begin(),clique_stub_vector_.end(),gen_);
     shuffle(node_stub_vector_.begin(),node_stub_vector_.end(),gen_);
 
-    //initialize clique sets
-    vector<vector<Node>> clique_vector(clique_size_sequence_.size());
-
-    //define the edge list and try the matching process
-    multiset<pair<Node,Node>> edge_multiset;
-
     //insert members in cliques
-    for (size_t i = 0; i < clique_stub_vector_.size(); i++)
+    CliqueMembership membership = clique_membership(clique_size_sequence_,
+            clique_stub_vector_, node_stub_vector_);
+
+    //position of the first pair of each clique
+    size_t n_cliques = clique_size_sequence_.size();
+    vector<size_t> pair_offsets(n_cliques+1, 0);
+    for (size_t c = 0; c < n_cliques; c++)
     {
-        clique_vector[clique_stub_vector_[i]].push_back(
-                node_stub_vector_[i]);
+        size_t k = membership.offsets[c+1] - membership.offsets[c];
+        pair_offsets[c+1] = pair_offsets[c] + k*(k-1)/2;
     }
 
-    //For each clique, get the edges
-    for (auto& clique : clique_vector)
+    //For each clique, get the edges (smaller node label first)
+    keys.resize(pair_offsets.back());
+    parallel_for(n_cliques, n_threads, [&](size_t begin, size_t end)
+            {
+                for (size_t c = begin; c < end; c++)
+                {
+                    size_t position = pair_offsets[c];
+                    for (size_t i = membership.offsets[c];
+                            i < membership.offsets[c+1]; i++)
+                    {
+                        for (size_t j = i+1; j < membership.offsets[c+1]; j++)
+                        {
+                            keys[position++] = undirected_edge_key(
+                                    BasicEdge<Node>(membership.members[i],
+                                        membership.members[j]));
+                        }
+                    }
+                }
+            });
+    parallel_radix_sort(keys, n_threads);
+    return membership;
+}
+
+//count the runs of equal keys of a sorted array, in blocks starting at the
+//beginning of a run. allocate(n_runs) is called once the runs are counted,
+//then write(r, key, count) for each run r, in parallel
+template<typename Key, typename Allocate, typename Write>
+void count_runs(const vector<Key>& keys, unsigned int n_threads,
+        Allocate allocate, Write write)
+{
+    n_threads = thread_count(n_threads);
+    vector<size_t> block_start(n_threads+1, keys.size());
+    for (unsigned int t = 0; t < n_threads; t++)
     {
-        auto iter1 = clique.begin();
-        auto iter2 = clique.begin();
-        for (; iter1 != clique.end(); iter1++)
+        size_t start = keys.size()*t/n_threads;
+        while (start > 0 and start < keys.size() and
+                keys[start] == keys[start-1])
         {
-            iter2 = iter1;
-            iter2++;
-            for (; iter2 != clique.end(); iter2++)
+            start++;
+        }
+        block_start[t] = start;
+    }
+
+    //index of the first run of each block
+    vector<size_t> first_run(n_threads+1, 0);
+    parallel_for(n_threads, n_threads, [&](size_t begin, size_t end)
             {
-                //smaller node label first
-                if (*iter1 <= *iter2)
+                for (size_t t = begin; t < end; t++)
                 {
-                    edge_multiset.emplace(*iter1,*iter2);
+                    size_t last = max(block_start[t], block_start[t+1]);
+                    for (size_t i = block_start[t]; i < last; i++)
+                    {
+                        if (i == block_start[t] or keys[i] != keys[i-1])
+                            first_run[t+1] += 1;
+                    }
                 }
-                else
+            });
+    partial_sum(first_run.begin(), first_run.end(), first_run.begin());
+    allocate(first_run.back());
+
+    parallel_for(n_threads, n_threads, [&](size_t begin, size_t end)
+            {
+                for (size_t t = begin; t < end; t++)
                 {
-                    edge_multiset.emplace(*iter2,*iter1);
+                    size_t last = max(block_start[t], block_start[t+1]);
+                    size_t r = first_run[t];
+                    for (size_t i = block_start[t]; i < last;)
+                    {
+                        size_t j = i + 1;
+                        while (j < keys.size() and keys[j] == keys[i])
+                        {
+                            j++;
+                        }
+                        write(r++, keys[i], j - i);
+                        i = j;
+                    }
                 }
-                //if the same label, the edge is not created
+            });
+}
+
+//get a clustered multigraph realization with flat clique membership. The
+//pairs of each clique are written as packed keys in a flat array, radix
+//sorted, and each run of equal keys gives one (i,j,count) triplet.
+template<typename NodeType>
+pair<BasicEdgeTriplet<NodeType>,BasicCliqueMembership<NodeType>>
+    BasicClusteredGraphGenerator<NodeType>::get_multigraph_2_flat(
+        unsigned int n_threads)
+{
+    typedef typename EdgeKey<Node>::type Key;
+    vector<Key> keys;
+    CliqueMembership membership = multigraph_2_keys(keys, n_threads);
+    EdgeTriplet edge_triplet;
+    count_runs(keys, n_threads,
+            [&](size_t n_runs) {edge_triplet.resize(n_runs);},
+            [&](size_t r, const Key& key, size_t count)
+            {
+                BasicEdge<Node> edge = key_edge<Node>(key);
+                edge_triplet[r] = make_tuple(edge.first, edge.second, count);
+            });
+    return make_pair(move(edge_triplet),move(membership));
+}
+
+//get a clustered multigraph realization as the columns (i, j, count) of the
+//triplets of get_multigraph_2_flat, written directly
+template<typename NodeType>
+pair<BasicEdgeCounts<NodeType>,BasicCliqueMembership<NodeType>>
+    BasicClusteredGraphGenerator<NodeType>::get_multigraph_2_columns(
+        unsigned int n_threads)
+{
+    typedef typename EdgeKey<Node>::type Key;
+    vector<Key> keys;
+    CliqueMembership membership = multigraph_2_keys(keys, n_threads);
+    EdgeCounts edge_counts;
+    count_runs(keys, n_threads,
+            [&](size_t n_runs)
+            {
+                edge_counts.first.resize(n_runs);
+                edge_counts.second.resize(n_runs);
+                edge_counts.count.resize(n_runs);
+            },
+            [&](size_t r, const Key& key, size_t count)
+            {
+                BasicEdge<Node> edge = key_edge<Node>(key);
+                edge_counts.first[r] = edge.first;
+                edge_counts.second[r] = edge.second;
+                edge_counts.count[r] = count;
+            });
+    return make_pair(move(edge_counts),move(membership));
+}
+
+
+/* ========================================
+ * Clustered graph sampler
+ * ======================================== */
+
+//Constructor of clustered graph sampler, starting from a random matching of
+//the membership and clique stubs
+template<typename NodeType>
+BasicClusteredGraphSampler<NodeType>::BasicClusteredGraphSampler(
+        vector<unsigned int> membership_sequence,
+        vector<unsigned int> clique_size_sequence,
+        unsigned int seed) :
+    gen_(seed), membership_sequence_(move(membership_sequence)),
+    membership_(), clique_of_stub_(), edge_count_(), added_edges_(),
+    removed_edges_(), compacted_size_(0)
+{
+    if (accumulate(clique_size_sequence.begin(), clique_size_sequence.end(),
+                size_t(0)) != accumulate(membership_sequence_.begin(),
+                membership_sequence_.end(), size_t(0)))
+    {
+        throw invalid_argument(
+                "Membership and clique size sequence do not match");
+    }
+    vector<Node> node_stub_vector = stub_vector<Node>(membership_sequence_);
+    clique_of_stub_ = stub_vector<Node>(clique_size_sequence);
+    shuffle(node_stub_vector.begin(), node_stub_vector.end(), gen_);
+    membership_ = clique_membership(clique_size_sequence, clique_of_stub_,
+            node_stub_vector);
+
+    //count the cliques joining each pair of distinct members
+    for (size_t c = 0; c+1 < membership_.offsets.size(); c++)
+    {
+        auto first = membership_.members.begin() + membership_.offsets[c];
+        auto last = membership_.members.begin() + membership_.offsets[c+1];
+        sort(first, last);
+        for (auto i = first; i != last; i++)
+        {
+            for (auto j = i+1; j != last; j++)
+            {
+                if (*j != *i and *j != *(j-1))
+                    edge_count_.insert(undirected_edge_key(
+                                BasicEdge<Node>(*i, *j)));
+            }
+            //skip the repeated members
+            while (i+1 != last and *(i+1) == *i)
+            {
+                ++i;
             }
         }
     }
-    //transform multiset into a vector
-    EdgeTriplet edge_triplet;
-    for (auto& edge : edge_multiset)
+}
+
+//add (or remove) the pairs between member and the other members of clique
+//c, unless member appears several times in c
+template<typename NodeType>
+void BasicClusteredGraphSampler<NodeType>::project(size_t c, Node member,
+        bool add)
+{
+    const Node* first = membership_.members.data() + membership_.offsets[c];
+    const Node* last = membership_.members.data() + membership_.offsets[c+1];
+    if (upper_bound(first, last, member) - lower_bound(first, last, member)
+            != 1)
+        return;
+    for (const Node* i = first; i != last; i++)
+    {
+        if (*i == member or (i != first and *i == *(i-1)))
+            continue;
+        Key key = undirected_edge_key(BasicEdge<Node>(member, *i));
+        if (add and edge_count_.insert(key) == 1)
+            added_edges_.push_back(key);
+        else if (not add and edge_count_.erase(key) == 0)
+            removed_edges_.push_back(key);
+    }
+}
+
+//replace old_member by new_member in the sorted members of clique c
+template<typename NodeType>
+void BasicClusteredGraphSampler<NodeType>::replace_member(size_t c,
+        Node old_member, Node new_member)
+{
+    Node* first = membership_.members.data() + membership_.offsets[c];
+    Node* last = membership_.members.data() + membership_.offsets[c+1];
+    Node* position = lower_bound(first, last, old_member);
+    Node* target = lower_bound(first, last, new_member);
+    if (target > position)
+    {
+        move(position+1, target, position);
+        *(target-1) = new_member;
+    }
+    else
+    {
+        move_backward(target, position, position+1);
+        *target = new_member;
+    }
+}
+
+//swap the nodes of two random membership stubs, if they are in different
+//cliques
+template<typename NodeType>
+void BasicClusteredGraphSampler<NodeType>::membership_swap()
+{
+    size_t stub1 = random_int(clique_of_stub_.size(), gen_);
+    size_t stub2 = random_int(clique_of_stub_.size(), gen_);
+    size_t c1 = clique_of_stub_[stub1];
+    size_t c2 = clique_of_stub_[stub2];
+    Node u = membership_.members[stub1];
+    Node v = membership_.members[stub2];
+    if (c1 == c2 or u == v)
+        return;
+
+    //u leaves c1 for c2, v leaves c2 for c1
+    project(c1, u, false);
+    replace_member(c1, u, v);
+    project(c1, v, true);
+    project(c2, v, false);
+    replace_member(c2, v, u);
+    project(c2, u, true);
+
+    //keep the log of the projected edges bounded, in amortized O(1)
+    if (added_edges_.size() + removed_edges_.size() > 2*compacted_size_ +
+            1024)
+        compact_delta();
+}
+
+//reduce the logs to the net edges added and removed, an edge alternates
+//between being added and removed
+template<typename NodeType>
+void BasicClusteredGraphSampler<NodeType>::compact_delta()
+{
+    radix_sort(added_edges_);
+    radix_sort(removed_edges_);
+    vector<Key> added;
+    vector<Key> removed;
+    set_difference(added_edges_.begin(), added_edges_.end(),
+            removed_edges_.begin(), removed_edges_.end(),
+            back_inserter(added));
+    set_difference(removed_edges_.begin(), removed_edges_.end(),
+            added_edges_.begin(), added_edges_.end(),
+            back_inserter(removed));
+    added_edges_.swap(added);
+    removed_edges_.swap(removed);
+    compacted_size_ = added_edges_.size() + removed_edges_.size();
+}
+
+//return the projected graph after step membership swaps, with the clique
+//membership without repeated members
+template<typename NodeType>
+pair<BasicEdgeList<NodeType>,BasicCliqueMembership<NodeType>>
+    BasicClusteredGraphSampler<NodeType>::get_graph(unsigned int step)
+{
+    for (unsigned int i = 0; i < step; i++)
     {
-        edge_triplet.emplace_back(edge.first,edge.second,edge_multiset.count(edge));
+        membership_swap();
     }
+    added_edges_.clear();
+    removed_edges_.clear();
+    compacted_size_ = 0;
 
-    return make_pair(edge_triplet,clique_vector);
+    //edges sorted by packed key, as in the clustered graph generator
+    vector<Key> keys;
+    keys.reserve(edge_count_.size());
+    edge_count_.for_each([&](Key key, unsigned int)
+            {
+                keys.push_back(key);
+            });
+    radix_sort(keys);
+    EdgeList edge_list(keys.size());
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        edge_list[i] = key_edge<Node>(keys[i]);
+    }
+    CliqueMembership membership = membership_;
+    remove_repeated_members(membership);
+    return make_pair(move(edge_list), move(membership));
 }
 
+//return the projected edges added and removed since the last sample, after
+//step membership swaps
+template<typename NodeType>
+pair<BasicEdgeList<NodeType>,BasicEdgeList<NodeType>>
+    BasicClusteredGraphSampler<NodeType>::get_edge_delta(unsigned int step)
+{
+    for (unsigned int i = 0; i < step; i++)
+    {
+        membership_swap();
+    }
+    compact_delta();
+    EdgeList added(added_edges_.size());
+    for (size_t i = 0; i < added_edges_.size(); i++)
+    {
+        added[i] = key_edge<Node>(added_edges_[i]);
+    }
+    EdgeList removed(removed_edges_.size());
+    for (size_t i = 0; i < removed_edges_.size(); i++)
+    {
+        removed[i] = key_edge<Node>(removed_edges_[i]);
+    }
+    added_edges_.clear();
+    removed_edges_.clear();
+    compacted_size_ = 0;
+    return make_pair(move(added), move(removed));
+}
 
 /* ========================================
  * Segregated graph generator
  * ======================================== */
 
 //Constructor of segregated graph generator
-SegregatedGraphGenerator::SegregatedGraphGenerator(
-        const vector<unsigned int>& membership_sequence,
-        const vector<unsigned int>& clique_size_sequence,
+template<typename NodeType>
+BasicSegregatedGraphGenerator<NodeType>::BasicSegregatedGraphGenerator(
+        vector<unsigned int> membership_sequence,
+        vector<unsigned int> clique_size_sequence,
         unsigned int seed) :
-    gen_(seed), membership_sequence_(membership_sequence),
-    clique_size_sequence_(clique_size_sequence), clique_stub_vector_(),
+    gen_(seed), membership_sequence_(move(membership_sequence)),
+    clique_size_sequence_(move(clique_size_sequence)), clique_stub_vector_(),
     node_stub_vector_()
 {
     try
     {
-        if (accumulate(clique_size_sequence.begin(), clique_size_sequence.end(),
-                    0) != accumulate(membership_sequence.begin(),
-                    membership_sequence.end(), 0))
+        if (accumulate(clique_size_sequence_.begin(),
+                    clique_size_sequence_.end(), size_t(0)) != accumulate(
+                    membership_sequence_.begin(), membership_sequence_.end(),
+                    size_t(0)))
         {
             throw invalid_argument(
                     "Membership and clique size sequence do not match");
         }
         //initialize clique and node stub vector
-        for (Node i = 0; i < membership_sequence_.size(); i++)
-        {
-            for (int j = 0; j < membership_sequence_[i]; j++)
-            {
-                node_stub_vector_.push_back(i);
-            }
-        }
-        for (unsigned int i = 0; i < clique_size_sequence_.size(); i++)
-        {
-            for (int j = 0; j < clique_size_sequence_[i]; j++)
-            {
-                clique_stub_vector_.push_back(i);
-            }
-        }
+        node_stub_vector_ = stub_vector<Node>(membership_sequence_);
+        clique_stub_vector_ = stub_vector<Node>(clique_size_sequence_);
     }
     catch (invalid_argument& e)
     {
@@ -468,37 +2356,46 @@ SegregatedGraphGenerator::SegregatedGraphGenerator(
 }
 
 //get a segregated graph realization
-pair<EdgeList,vector<set<Node>>> SegregatedGraphGenerator::get_graph()
+template<typename NodeType>
+pair<BasicEdgeList<NodeType>,vector<set<NodeType>>>
+    BasicSegregatedGraphGenerator<NodeType>::get_graph()
+{
+    pair<EdgeList,CliqueMembership> graph = get_graph_flat();
+    return make_pair(move(graph.first), clique_sets(graph.second));
+}
+
+//get a segregated graph realization with flat clique membership
+template<typename NodeType>
+pair<BasicEdgeList<NodeType>,BasicCliqueMembership<NodeType>>
+    BasicSegregatedGraphGenerator<NodeType>::get_graph_flat()
 {
     //shuffle the stub vectors
     shuffle(clique_stub_vector_.begin(),clique_stub_vector_.end(),gen_);
     shuffle(node_stub_vector_.begin(),node_stub_vector_.end(),gen_);
 
-    //initialize clique surrogate sets
-    vector<set<Node>> clique_vector(clique_size_sequence_.size());
+    //insert members in cliques surrogate, each member appears once
+    CliqueMembership membership = clique_membership(clique_size_sequence_,
+            clique_stub_vector_, node_stub_vector_);
+    remove_repeated_members(membership);
 
     //define the edge set and try the matching process
     EdgeSet edge_set;
 
-    //insert members in cliques surrogate
-    for (size_t i = 0; i < clique_stub_vector_.size(); i++)
-    {
-        clique_vector[clique_stub_vector_[i]].insert(
-                node_stub_vector_[i]);
-    }
-
     //Build edge-stub list for each type of stub (associated to clique size)
-    unordered_map<size_t,vector<Node>> stub_vector_map(clique_vector.size());
-    for (auto& clique : clique_vector)
+    unordered_map<size_t,vector<Node>> stub_vector_map(
+            clique_size_sequence_.size());
+    for (size_t c = 0; c < clique_size_sequence_.size(); c++)
     {
-        size_t n = clique.size();
+        size_t n = membership.offsets[c+1] - membership.offsets[c];
         if (stub_vector_map.count(n) == 0)
         {
             stub_vector_map[n] = vector<Node>();
         }
-        for (auto& node : clique)
+        for (size_t i = membership.offsets[c]; i < membership.offsets[c+1];
+                i++)
         {
-            stub_vector_map[n].insert(stub_vector_map[n].end(), n-1, node);
+            stub_vector_map[n].insert(stub_vector_map[n].end(), n-1,
+                    membership.members[i]);
         }
     }
 
@@ -527,41 +2424,49 @@ pair<EdgeList,vector<set<Node>>> SegregatedGraphGenerator::get_graph()
     }
 
     return make_pair(EdgeList(edge_set.begin(), edge_set.end()),
-            clique_vector);
+            move(membership));
 }
 
 //get a segregated multigraph realization
-pair<EdgeList,vector<vector<Node>>> SegregatedGraphGenerator::get_multigraph()
+template<typename NodeType>
+pair<BasicEdgeList<NodeType>,vector<vector<NodeType>>>
+    BasicSegregatedGraphGenerator<NodeType>::get_multigraph()
+{
+    pair<EdgeList,CliqueMembership> graph = get_multigraph_flat();
+    return make_pair(move(graph.first), clique_vectors(graph.second));
+}
+
+//get a segregated multigraph realization with flat clique membership
+template<typename NodeType>
+pair<BasicEdgeList<NodeType>,BasicCliqueMembership<NodeType>>
+    BasicSegregatedGraphGenerator<NodeType>::get_multigraph_flat()
 {
     //shuffle the stub vectors
     shuffle(clique_stub_vector_.begin(),clique_stub_vector_.end(),gen_);
     shuffle(node_stub_vector_.begin(),node_stub_vector_.end(),gen_);
 
-    //initialize clique surrogate sets
-    vector<vector<Node>> clique_vector(clique_size_sequence_.size());
+    //insert members in cliques surrogate
+    CliqueMembership membership = clique_membership(clique_size_sequence_,
+            clique_stub_vector_, node_stub_vector_);
 
     //define the edge list and try the matching process
     EdgeList edge_list;
 
-    //insert members in cliques surrogate
-    for (size_t i = 0; i < clique_stub_vector_.size(); i++)
-    {
-        clique_vector[clique_stub_vector_[i]].push_back(
-                node_stub_vector_[i]);
-    }
-
     //Build edge-stub list for each type of stub (associated to clique size)
-    unordered_map<size_t,vector<Node>> stub_vector_map(clique_vector.size());
-    for (auto& clique : clique_vector)
+    unordered_map<size_t,vector<Node>> stub_vector_map(
+            clique_size_sequence_.size());
+    for (size_t c = 0; c < clique_size_sequence_.size(); c++)
     {
-        size_t n = clique.size();
+        size_t n = membership.offsets[c+1] - membership.offsets[c];
         if (stub_vector_map.count(n) == 0)
         {
             stub_vector_map[n] = vector<Node>();
         }
-        for (auto& node : clique)
+        for (size_t i = membership.offsets[c]; i < membership.offsets[c+1];
+                i++)
         {
-            stub_vector_map[n].insert(stub_vector_map[n].end(), n-1, node);
+            stub_vector_map[n].insert(stub_vector_map[n].end(), n-1,
+                    membership.members[i]);
         }
     }
 
@@ -589,8 +2494,122 @@ pair<EdgeList,vector<vector<Node>>> SegregatedGraphGenerator::get_multigraph()
         }
     }
 
-    return make_pair(edge_list, clique_vector);
+    return make_pair(move(edge_list), move(membership));
+}
+
+
+/* ========================================
+ * Chung-Lu graph generator
+ * ======================================== */
+
+//Constructor of Chung-Lu graph generator
+template<typename NodeType>
+BasicChungLuGenerator<NodeType>::BasicChungLuGenerator(
+        const vector<double>& weight_sequence, unsigned int seed) :
+    gen_(seed), total_weight_(0), sorted_weights_(), order_()
+{
+    for (double weight : weight_sequence)
+    {
+        if (not (weight >= 0) or std::isinf(weight))
+        {
+            throw invalid_argument(
+                    "Weights must be finite and non-negative");
+        }
+        total_weight_ += weight;
+    }
+    //order_[i] is the label of the node with the i-th largest weight
+    order_.resize(weight_sequence.size());
+    iota(order_.begin(), order_.end(), Node(0));
+    stable_sort(order_.begin(), order_.end(), [&](Node i, Node j)
+            {
+                return weight_sequence[i] > weight_sequence[j];
+            });
+    sorted_weights_.reserve(order_.size());
+    for (Node node : order_)
+    {
+        sorted_weights_.push_back(weight_sequence[node]);
+    }
+}
+
+//get a Chung-Lu graph realization, where the edge (u,v) exists with
+//probability min(w_u w_v / W, 1)
+template<typename NodeType>
+BasicEdgeList<NodeType> BasicChungLuGenerator<NodeType>::get_graph()
+{
+    EdgeList edge_list;
+    size_t N = sorted_weights_.size();
+    if (total_weight_ == 0)
+    {
+        return edge_list;
+    }
+    for (size_t u = 0; u + 1 < N; u++)
+    {
+        size_t v = u + 1;
+        double p = min(sorted_weights_[u]*sorted_weights_[v]/total_weight_,
+                1.);
+        while (v < N and p > 0)
+        {
+            //skip the nodes that would not be connected with probability p
+            if (p < 1.)
+            {
+                double r = 1 - random_01(gen_);
+                double skip = floor(log(r)/log(1 - p));
+                if (skip >= N - v)
+                {
+                    break;
+                }
+                v += skip;
+            }
+            //the weights decrease, so accept with probability q/p
+            double q = min(sorted_weights_[u]*sorted_weights_[v]/
+                    total_weight_, 1.);
+            if (random_01(gen_) < q/p)
+            {
+                Node node1 = order_[u];
+                Node node2 = order_[v];
+                if (node1 < node2)
+                    edge_list.emplace_back(node1, node2);
+                else
+                    edge_list.emplace_back(node2, node1);
+            }
+            p = q;
+            v += 1;
+        }
+    }
+    return edge_list;
 }
 
 
+/* ========================================
+ * Explicit instantiations
+ * ======================================== */
+
+template class BasicConfigurationModelGenerator<uint32_t>;
+template class BasicDirectedConfigurationModelGenerator<uint32_t>;
+template class BasicBipartiteConfigurationModelGenerator<uint32_t>;
+template class BasicConfigurationModelSampler<uint32_t>;
+template class BasicCurveballSampler<uint32_t>;
+template class BasicClusteredGraphGenerator<uint32_t>;
+template class BasicClusteredGraphSampler<uint32_t>;
+template class BasicSegregatedGraphGenerator<uint32_t>;
+template class BasicChungLuGenerator<uint32_t>;
+template class BasicJointDegreeGenerator<uint32_t>;
+template RepairStatus rewire_faulty_edges(BasicEdgeList<uint32_t>&,
+        RNGType&, size_t, double, EdgeType);
+template void rewire_faulty_edges_sorted(BasicEdgeList<uint32_t>&, RNGType&);
+
+template class BasicConfigurationModelGenerator<uint64_t>;
+template class BasicDirectedConfigurationModelGenerator<uint64_t>;
+template class BasicBipartiteConfigurationModelGenerator<uint64_t>;
+template class BasicConfigurationModelSampler<uint64_t>;
+template class BasicCurveballSampler<uint64_t>;
+template class BasicClusteredGraphGenerator<uint64_t>;
+template class BasicClusteredGraphSampler<uint64_t>;
+template class BasicSegregatedGraphGenerator<uint64_t>;
+template class BasicChungLuGenerator<uint64_t>;
+template class BasicJointDegreeGenerator<uint64_t>;
+template RepairStatus rewire_faulty_edges(BasicEdgeList<uint64_t>&,
+        RNGType&, size_t, double, EdgeType);
+template void rewire_faulty_edges_sorted(BasicEdgeList<uint64_t>&, RNGType&);
+
 }//end of namespace rggen
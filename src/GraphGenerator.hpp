@@ -29,6 +29,7 @@
 #include <utility>
 #include <vector>
 #include <set>
+#include <map>
 #include <unordered_set>
 #include <unordered_map>
 #include <random>
@@ -39,116 +40,851 @@
 #include <limits>
 #include <cmath>
 #include <tuple>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <exception>
+#include <algorithm>
+#include <chrono>
+#include <functional>
 
 
 namespace rggen
 {//start of namespace rggen
 
-typedef unsigned int Node;
+//the nodes are indexed with 32 bits integers by default, which keeps the edge
+//lists compact, and with 64 bits integers for more than 2^32 nodes
+typedef uint32_t Node;
 typedef pcg32 RNGType;
-typedef std::pair<Node,Node> Edge;
-typedef std::vector<std::pair<Node,Node> > EdgeList;
-typedef std::vector<std::tuple<Node,Node,std::size_t> > EdgeTriplet;
-typedef std::set<std::pair<Node,Node> > EdgeSet;
+
+template<typename NodeType>
+using BasicEdge = std::pair<NodeType,NodeType>;
+template<typename NodeType>
+using BasicEdgeList = std::vector<std::pair<NodeType,NodeType> >;
+template<typename NodeType>
+using BasicEdgeTriplet = std::vector<std::tuple<NodeType,NodeType,
+      std::size_t> >;
+template<typename NodeType>
+using BasicEdgeSet = std::set<std::pair<NodeType,NodeType> >;
+
+//sparse joint degree matrix, each entry (k, l, m) is the number m of edges
+//between the nodes of degree k and the nodes of degree l. An entry (l, k)
+//gives the same edges: it is either omitted, or equal for a symmetric matrix,
+//and m_kk counts each edge once
+typedef std::vector<std::tuple<unsigned int,unsigned int,std::size_t> >
+    JointDegreeMatrix;
+
+typedef BasicEdge<Node> Edge;
+typedef BasicEdgeList<Node> EdgeList;
+typedef BasicEdgeTriplet<Node> EdgeTriplet;
+typedef BasicEdgeSet<Node> EdgeSet;
+
+//number of stubs above which the stubs are shuffled in parallel
+const std::size_t PARALLEL_SHUFFLE_THRESHOLD = 1000000000;
+
+/*
+ * Compressed sparse row adjacency. The neighbors of node i are
+ * indices[indptr[i]], ..., indices[indptr[i+1]-1]; undirected edges appear in
+ * both directions.
+ */
+template<typename NodeType>
+struct BasicCSRGraph
+{
+    std::vector<std::size_t> indptr;
+    std::vector<NodeType> indices;
+};
+typedef BasicCSRGraph<Node> CSRGraph;
+
+/*
+ * Flat clique membership. The members of clique c are
+ * members[offsets[c]], ..., members[offsets[c+1]-1].
+ */
+template<typename NodeType>
+struct BasicCliqueMembership
+{
+    std::vector<std::size_t> offsets;
+    std::vector<NodeType> members;
+};
+typedef BasicCliqueMembership<Node> CliqueMembership;
+
+/*
+ * Multiedges as columns. The edge (first[e], second[e]) appears count[e]
+ * times.
+ */
+template<typename NodeType>
+struct BasicEdgeCounts
+{
+    std::vector<NodeType> first;
+    std::vector<NodeType> second;
+    std::vector<std::size_t> count;
+};
+typedef BasicEdgeCounts<Node> EdgeCounts;
+
+/*
+ * Outcome of the rewiring of a multigraph into a simple graph
+ */
+enum class RepairStatus {SUCCESS, BUDGET_EXHAUSTED};
+
+//kind of edges handled by the rewiring: undirected edges are stored with the
+//smaller node first, directed edges are (source, target) and bipartite edges
+//are (node, clique), so (i,i) is not a self-loop
+enum class EdgeType {UNDIRECTED, DIRECTED, BIPARTITE};
+
+/*
+ * Number of edges removed from a multigraph to obtain the erased (simple)
+ * graph.
+ */
+struct ErasedEdges
+{
+    std::size_t self_loops;
+    std::size_t multiedges;
+};
+
+/*
+ * Observables of a MCMC sampler, counted since the tracking started. The
+ * rejections only happen for simple graphs, or with a target transitivity
+ * for the Metropolis rule, and the triangles are only counted if requested.
+ */
+struct SamplerObservables
+{
+    std::size_t swaps;
+    std::size_t accepted;
+    std::size_t rejected_self_loops;
+    std::size_t rejected_multiedges;
+    std::size_t rejected_metropolis;
+    double assortativity;
+    std::size_t triangles;
+};
+
+//integer type of a packed edge, twice as wide as the node index
+template<typename NodeType>
+struct EdgeKey;
+
+template<>
+struct EdgeKey<uint32_t>
+{
+    typedef uint64_t type;
+};
+
+template<>
+struct EdgeKey<uint64_t>
+{
+    typedef pcg_extras::pcg128_t type;
+};
+
+//pack an edge in an integer twice as wide as the nodes
+template<typename NodeType>
+inline typename EdgeKey<NodeType>::type edge_key(
+        const BasicEdge<NodeType>& edge)
+{
+    typedef typename EdgeKey<NodeType>::type Key;
+    return (static_cast<Key>(edge.first) << 8*sizeof(NodeType)) |
+        edge.second;
+}
+
+//pack an undirected edge with the smaller node first
+template<typename NodeType>
+inline typename EdgeKey<NodeType>::type undirected_edge_key(
+        const BasicEdge<NodeType>& edge)
+{
+    return edge.first <= edge.second ? edge_key(edge) :
+        edge_key(BasicEdge<NodeType>(edge.second, edge.first));
+}
+
+//unpack an edge from an integer twice as wide as the nodes
+template<typename NodeType, typename Key>
+inline BasicEdge<NodeType> key_edge(Key key)
+{
+    return BasicEdge<NodeType>(
+            static_cast<NodeType>(key >> 8*sizeof(NodeType)),
+            static_cast<NodeType>(key));
+}
+
+//fold a packed edge in 64 bits before hashing
+inline uint64_t fold_key(uint64_t key)
+{
+    return key;
+}
+
+inline uint64_t fold_key(pcg_extras::pcg128_t key)
+{
+    return static_cast<uint64_t>(key >> 64)*0xC2B2AE3D27D4EB4FULL ^
+        static_cast<uint64_t>(key);
+}
+
+/*
+ * Multiset of packed edges using open addressing with linear probing. A slot
+ * with a null count is empty, and erased slots are filled by shifting back
+ * the following entries, so there are no tombstones.
+ */
+template<typename Key>
+class BasicEdgeMultiset
+{
+public:
+    BasicEdgeMultiset(std::size_t expected_size = 0) :
+        size_(0), mask_(0), shift_(0), keys_(), counts_()
+        {rehash(expected_size);}
+
+    std::size_t size() const
+        {return size_;}
+
+    unsigned int count(Key key) const
+    {
+        for (std::size_t slot = slot_of(key); counts_[slot];
+                slot = (slot+1) & mask_)
+        {
+            if (keys_[slot] == key)
+                return counts_[slot];
+        }
+        return 0;
+    }
+
+    //add one copy of key, return its new count
+    unsigned int insert(Key key)
+    {
+        if (2*(size_+1) > keys_.size())
+            rehash(size_+1);
+        std::size_t slot = slot_of(key);
+        for (; counts_[slot]; slot = (slot+1) & mask_)
+        {
+            if (keys_[slot] == key)
+                return ++counts_[slot];
+        }
+        keys_[slot] = key;
+        counts_[slot] = 1;
+        size_ += 1;
+        return 1;
+    }
+
+    //remove one copy of key, if present, return its new count
+    unsigned int erase(Key key)
+    {
+        std::size_t slot = slot_of(key);
+        for (; counts_[slot]; slot = (slot+1) & mask_)
+        {
+            if (keys_[slot] == key)
+                break;
+        }
+        if (counts_[slot] == 0)
+            return 0;
+        if (--counts_[slot] > 0)
+            return counts_[slot];
+        size_ -= 1;
+        //shift back the entries that were displaced past the empty slot
+        std::size_t hole = slot;
+        for (slot = (slot+1) & mask_; counts_[slot]; slot = (slot+1) & mask_)
+        {
+            std::size_t home = slot_of(keys_[slot]);
+            if (((slot - home) & mask_) >= ((slot - hole) & mask_))
+            {
+                keys_[hole] = keys_[slot];
+                counts_[hole] = counts_[slot];
+                counts_[slot] = 0;
+                hole = slot;
+            }
+        }
+        return 0;
+    }
+
+    //call f(key, count) for each distinct key, in no particular order
+    template<typename Function>
+    void for_each(Function f) const
+    {
+        for (std::size_t slot = 0; slot < keys_.size(); slot++)
+        {
+            if (counts_[slot])
+                f(keys_[slot], counts_[slot]);
+        }
+    }
+
+private:
+    std::size_t slot_of(Key key) const
+    {
+        //multiplicative hashing, the high bits are the best mixed
+        return (fold_key(key) * 0x9E3779B97F4A7C15ULL) >> (64 - shift_);
+    }
+
+    //resize to hold at least n keys with a load factor below 1/2
+    void rehash(std::size_t n)
+    {
+        std::size_t capacity = 16;
+        unsigned int shift = 4;
+        while (capacity < 2*n)
+        {
+            capacity *= 2;
+            shift += 1;
+        }
+        if (capacity <= keys_.size())
+            return;
+        shift_ = shift;
+        std::vector<Key> keys(capacity);
+        std::vector<unsigned int> counts(capacity, 0);
+        keys.swap(keys_);
+        counts.swap(counts_);
+        mask_ = capacity - 1;
+        for (std::size_t slot = 0; slot < keys.size(); slot++)
+        {
+            if (counts[slot])
+            {
+                std::size_t new_slot = slot_of(keys[slot]);
+                while (counts_[new_slot])
+                {
+                    new_slot = (new_slot+1) & mask_;
+                }
+                keys_[new_slot] = keys[slot];
+                counts_[new_slot] = counts[slot];
+            }
+        }
+    }
+
+    std::size_t size_;
+    std::size_t mask_;
+    unsigned int shift_;
+    std::vector<Key> keys_;
+    std::vector<unsigned int> counts_;
+};
+typedef BasicEdgeMultiset<uint64_t> EdgeMultiset;
 
 /*
  * Generation of configuration model graph using direct sampling. Can be simple
  * or not.
  */
-class ConfigurationModelGenerator
+template<typename NodeType>
+class BasicConfigurationModelGenerator
 {
 public:
-    ConfigurationModelGenerator(
-            const std::vector<unsigned int>& degree_sequence,
+    typedef NodeType Node;
+    typedef BasicEdgeList<Node> EdgeList;
+    typedef BasicCSRGraph<Node> CSRGraph;
+
+    BasicConfigurationModelGenerator(
+            std::vector<unsigned int> degree_sequence,
             unsigned int seed);
 
     //graph generation methods
-    EdgeList get_graph(bool simple_graph = false);
+    EdgeList get_graph(bool simple_graph = false,
+            unsigned int n_threads = 1);
+    CSRGraph get_graph_csr(bool simple_graph = false,
+            unsigned int n_threads = 1);
+    std::pair<EdgeList,ErasedEdges> get_erased_graph(
+            unsigned int n_threads = 1);
+    std::pair<EdgeList,std::vector<std::size_t>> get_graphs(std::size_t k,
+            unsigned int n_threads = 1, bool simple_graph = false) const;
+
+    //limit the rewiring into a simple graph, 0 means no limit
+    void set_repair_budget(std::size_t max_rewiring, double max_seconds)
+        {max_rewiring_ = max_rewiring; max_seconds_ = max_seconds;}
+
+    //accessors
+    std::size_t number_of_nodes() const
+        {return degree_sequence_.size();}
+    bool is_graphical() const
+        {return graphical_;}
+    RepairStatus status() const
+        {return status_;}
 
 
 private:
+    EdgeList sample_graph(RNGType& gen, bool simple_graph,
+            unsigned int n_threads, RepairStatus& status) const;
+    //members
+    unsigned int seed_;
     RNGType gen_;
     std::vector<unsigned int> degree_sequence_;
+    bool graphical_;
+    std::size_t max_rewiring_;
+    double max_seconds_;
+    RepairStatus status_;
+};
+
+/*
+ * Generation of directed configuration model graph: the out-stubs are
+ * matched with a random permutation of the in-stubs. Can be simple or not.
+ */
+template<typename NodeType>
+class BasicDirectedConfigurationModelGenerator
+{
+public:
+    typedef NodeType Node;
+    typedef BasicEdgeList<Node> EdgeList;
+    typedef BasicCSRGraph<Node> CSRGraph;
+
+    BasicDirectedConfigurationModelGenerator(
+            std::vector<unsigned int> in_degree_sequence,
+            std::vector<unsigned int> out_degree_sequence,
+            unsigned int seed);
+
+    //graph generation methods, edges are (source, target)
+    EdgeList get_graph(bool simple_graph = false,
+            unsigned int n_threads = 1);
+    CSRGraph get_graph_csr(bool simple_graph = false,
+            unsigned int n_threads = 1);
+
+    //limit the rewiring into a simple graph, 0 means no limit
+    void set_repair_budget(std::size_t max_rewiring, double max_seconds)
+        {max_rewiring_ = max_rewiring; max_seconds_ = max_seconds;}
+
+    //accessors
+    std::size_t number_of_nodes() const
+        {return out_degree_sequence_.size();}
+    bool is_graphical() const
+        {return graphical_;}
+    RepairStatus status() const
+        {return status_;}
+
+private:
+    RNGType gen_;
+    std::vector<unsigned int> in_degree_sequence_;
+    std::vector<unsigned int> out_degree_sequence_;
+    bool graphical_;
+    std::size_t max_rewiring_;
+    double max_seconds_;
+    RepairStatus status_;
+};
+
+/*
+ * Generation of the random bipartite graph between nodes and cliques used by
+ * the clustered graph generator, without its one-mode projection. The edges
+ * are (node, clique). Can be simple (no node twice in a clique) or not.
+ */
+template<typename NodeType>
+class BasicBipartiteConfigurationModelGenerator
+{
+public:
+    typedef NodeType Node;
+    typedef BasicEdgeList<Node> EdgeList;
+    typedef BasicCSRGraph<Node> CSRGraph;
+
+    BasicBipartiteConfigurationModelGenerator(
+            std::vector<unsigned int> membership_sequence,
+            std::vector<unsigned int> clique_size_sequence,
+            unsigned int seed);
+
+    //graph generation methods
+    EdgeList get_graph(bool simple_graph = false,
+            unsigned int n_threads = 1);
+    CSRGraph get_graph_csr(bool simple_graph = false,
+            unsigned int n_threads = 1);
+
+    //limit the rewiring into a simple graph, 0 means no limit
+    void set_repair_budget(std::size_t max_rewiring, double max_seconds)
+        {max_rewiring_ = max_rewiring; max_seconds_ = max_seconds;}
+
+    //accessors
+    std::size_t number_of_nodes() const
+        {return membership_sequence_.size();}
+    std::size_t number_of_cliques() const
+        {return clique_size_sequence_.size();}
+    bool is_graphical() const
+        {return graphical_;}
+    RepairStatus status() const
+        {return status_;}
+
+private:
+    RNGType gen_;
+    std::vector<unsigned int> membership_sequence_;
+    std::vector<unsigned int> clique_size_sequence_;
+    bool graphical_;
+    std::size_t max_rewiring_;
+    double max_seconds_;
+    RepairStatus status_;
+};
+
+/*
+ * Generation of graphs with a prescribed joint degree matrix. The stubs of
+ * each degree class are split evenly among its nodes between the pairs of
+ * classes, and matched pair by pair. Can be simple or not: the multiedges can
+ * only join nodes of the same pair of classes, so they are rewired within
+ * each pair.
+ */
+template<typename NodeType>
+class BasicJointDegreeGenerator
+{
+public:
+    typedef NodeType Node;
+    typedef BasicEdgeList<Node> EdgeList;
+    typedef BasicCSRGraph<Node> CSRGraph;
+
+    BasicJointDegreeGenerator(
+            std::vector<unsigned int> degree_sequence,
+            const JointDegreeMatrix& joint_degree_matrix,
+            unsigned int seed);
+
+    //graph generation methods
+    EdgeList get_graph(bool simple_graph = false,
+            unsigned int n_threads = 1);
+    CSRGraph get_graph_csr(bool simple_graph = false,
+            unsigned int n_threads = 1);
+
+    //limit the rewiring of each pair of classes into a simple graph, 0 means
+    //no limit
+    void set_repair_budget(std::size_t max_rewiring, double max_seconds)
+        {max_rewiring_ = max_rewiring; max_seconds_ = max_seconds;}
+
+    //accessors
+    std::size_t number_of_nodes() const
+        {return degree_sequence_.size();}
+    bool is_graphical() const
+        {return graphical_;}
+    RepairStatus status() const
+        {return status_;}
+
+private:
+    RNGType gen_;
+    std::vector<unsigned int> degree_sequence_;
+    //stubs grouped by degree class, the stubs of class c are
+    //class_stubs_[class_offset_[c]], ..., class_stubs_[class_offset_[c+1]-1]
+    std::vector<std::size_t> class_offset_;
+    std::vector<Node> class_stubs_;
+    //pairs of classes (c1 <= c2) with their number of edges
+    std::vector<std::tuple<std::size_t,std::size_t,std::size_t> >
+        class_pairs_;
+    bool graphical_;
+    std::size_t max_rewiring_;
+    double max_seconds_;
+    RepairStatus status_;
 };
 
 /*
  * Sampling of configuration model graph using MCMC
  */
-class ConfigurationModelSampler
+template<typename NodeType>
+class BasicConfigurationModelSampler
 {
 public:
-    ConfigurationModelSampler(
-            const EdgeList& edge_list,
+    typedef NodeType Node;
+    typedef BasicEdge<Node> Edge;
+    typedef BasicEdgeList<Node> EdgeList;
+    typedef BasicEdgeMultiset<typename EdgeKey<Node>::type> EdgeMultiset;
+
+    BasicConfigurationModelSampler(
+            EdgeList edge_list,
             unsigned int seed, bool simple_graph = true);
 
     //graph generation methods
     EdgeList get_graph(unsigned int step);
+    EdgeList get_graph_parallel(std::size_t step,
+            unsigned int n_threads = 0);
+    std::pair<EdgeList,std::vector<std::size_t>> get_graphs(std::size_t k,
+            unsigned int step, unsigned int n_threads = 1);
+    //hand n samples taken every step edge swaps to sink(i, edge_list)
+    void samples(std::size_t n, unsigned int step,
+            const std::function<void(std::size_t,const EdgeList&)>& sink);
+
+    //accessors
+    std::size_t number_of_nodes() const
+        {return number_of_nodes_;}
+    std::size_t number_of_edges() const
+        {return current_edge_list_.size();}
+
+    //record the observables every stride edge swaps, 0 stops the tracking
+    void track_observables(std::size_t stride, bool triangles = false);
+    const std::vector<SamplerObservables>& observables() const
+        {return observables_;}
+    //weight the graphs by exp(-beta |transitivity - target|)
+    void set_target_transitivity(double transitivity, double beta);
+    double transitivity() const;
 
 
 private:
+    //chain of get_graphs, starting from the edges of sampler with the RNG gen
+    BasicConfigurationModelSampler(const BasicConfigurationModelSampler&
+            sampler, RNGType gen);
     bool exists(const Edge& e) const;
     void edge_swap();
+    void init_observables();
+    void init_triangles();
+    std::size_t move_triangles(const Edge& e1, const Edge& e2,
+            const Edge& f1, const Edge& f2);
+    void record_swap(const Edge& e1, const Edge& e2, const Edge& f1,
+            const Edge& f2, bool accepted);
+    std::size_t common_neighbors(Node u, Node v) const;
+    void replace_neighbor(Node w, Node old_neighbor, Node new_neighbor);
     //members
     bool simple_graph_;
+    std::size_t number_of_nodes_;
     RNGType gen_;
     EdgeList current_edge_list_;
-    EdgeSet current_edge_set_;
+    //edges packed with the smaller node first, only kept for simple graphs
+    EdgeMultiset current_edge_set_;
+    //observables
+    std::size_t stride_;
+    bool track_triangles_;
+    SamplerObservables current_observables_;
+    std::vector<SamplerObservables> observables_;
+    std::vector<unsigned int> degree_sequence_;
+    //sum of k_i k_j over the edges, and the constant terms of assortativity
+    double degree_product_;
+    double mean_excess_;
+    double excess_variance_;
+    //Metropolis rule towards a target transitivity, disabled if beta_ = 0
+    double beta_;
+    double target_transitivity_;
+    //sorted neighbors, kept when the triangles are tracked or targeted
+    std::size_t triangles_;
+    double triples_;
+    BasicCSRGraph<Node> adjacency_;
+
+};
 
+/*
+ * Sampling of simple graphs with a given degree sequence using Curveball
+ * trades. The adjacency is kept in a CSR with sorted neighbors; a trade
+ * between u and v shuffles the neighbors that only one of them has and deals
+ * them back, keeping the degrees. A global trade pairs all the nodes with a
+ * random permutation.
+ */
+template<typename NodeType>
+class BasicCurveballSampler
+{
+public:
+    typedef NodeType Node;
+    typedef BasicEdgeList<Node> EdgeList;
+    typedef BasicCSRGraph<Node> CSRGraph;
+
+    BasicCurveballSampler(const EdgeList& edge_list, unsigned int seed);
+
+    //graph generation methods
+    EdgeList get_graph(unsigned int step);
+    EdgeList get_graph_global(unsigned int step);
+    const CSRGraph& get_graph_csr() const
+        {return adjacency_;}
+
+    //accessors
+    std::size_t number_of_nodes() const
+        {return adjacency_.indptr.size() - 1;}
+
+private:
+    void trade(Node u, Node v);
+    void replace_neighbor(Node w, Node old_neighbor, Node new_neighbor);
+    EdgeList edge_list() const;
+    //members
+    RNGType gen_;
+    CSRGraph adjacency_;
+    std::vector<Node> node_vector_;
+    //buffers of the trades
+    std::vector<Node> common_;
+    std::vector<Node> only_u_;
+    std::vector<Node> only_v_;
+    std::vector<Node> traded_;
 };
 
 /*
  * Generation of clustered networks using bipartite one-mode projection
  */
-class ClusteredGraphGenerator
+template<typename NodeType>
+class BasicClusteredGraphGenerator
 {
 public:
-    ClusteredGraphGenerator(
-            const std::vector<unsigned int>& membership_sequence,
-            const std::vector<unsigned int>& clique_size_sequence,
+    typedef NodeType Node;
+    typedef BasicEdgeList<Node> EdgeList;
+    typedef BasicEdgeTriplet<Node> EdgeTriplet;
+    typedef BasicEdgeSet<Node> EdgeSet;
+    typedef BasicCliqueMembership<Node> CliqueMembership;
+    typedef BasicEdgeCounts<Node> EdgeCounts;
+
+    BasicClusteredGraphGenerator(
+            std::vector<unsigned int> membership_sequence,
+            std::vector<unsigned int> clique_size_sequence,
             unsigned int seed);
 
-    //graph generation methods
-    std::pair<EdgeList,std::vector<std::set<Node>>> get_graph();
+    //graph generation methods, the edges are sorted unless sorted_output is
+    //false
+    std::pair<EdgeList,std::vector<std::set<Node>>> get_graph(
+            bool sorted_output = true, unsigned int n_threads = 1);
     std::pair<EdgeList,std::vector<std::vector<Node>>> get_multigraph();
-    std::pair<EdgeTriplet,std::vector<std::vector<Node>>> get_multigraph_2();
+    std::pair<EdgeTriplet,std::vector<std::vector<Node>>> get_multigraph_2(
+            unsigned int n_threads = 1);
+    std::pair<EdgeList,std::vector<std::size_t>> get_graphs(std::size_t k,
+            unsigned int n_threads = 1) const;
+
+    //graph generation methods with flat clique membership
+    std::pair<EdgeList,CliqueMembership> get_graph_flat(
+            bool sorted_output = true, unsigned int n_threads = 1);
+    std::pair<EdgeList,CliqueMembership> get_multigraph_flat();
+    std::pair<EdgeTriplet,CliqueMembership> get_multigraph_2_flat(
+            unsigned int n_threads = 1);
+    //same draw as get_multigraph_2_flat, with the triplets as columns
+    std::pair<EdgeCounts,CliqueMembership> get_multigraph_2_columns(
+            unsigned int n_threads = 1);
+
+    //accessors
+    std::size_t number_of_nodes() const
+        {return membership_sequence_.size();}
 
 private:
+    CliqueMembership multigraph_2_keys(
+            std::vector<typename EdgeKey<Node>::type>& keys,
+            unsigned int n_threads);
+    std::pair<EdgeList,CliqueMembership> sample_graph(
+            RNGType& gen, std::vector<Node>& clique_stub_vector,
+            std::vector<Node>& node_stub_vector, bool sorted_output,
+            unsigned int n_threads) const;
+    //members
+    unsigned int seed_;
     RNGType gen_;
     std::vector<unsigned int> membership_sequence_;
     std::vector<unsigned int> clique_size_sequence_;
-    std::vector<unsigned int> clique_stub_vector_;
+    std::vector<Node> clique_stub_vector_;
     std::vector<Node> node_stub_vector_;
 };
 
+/*
+ * Sampling of clustered networks using MCMC on the bipartite node-clique
+ * structure. The members of each clique are kept sorted in a flat clique
+ * membership, and a step swaps the nodes of two random membership stubs of
+ * different cliques. The number of cliques joining each pair of nodes is
+ * updated in O(clique size) per swap, and the projected edges created and
+ * destroyed are logged for the edge-delta output.
+ */
+template<typename NodeType>
+class BasicClusteredGraphSampler
+{
+public:
+    typedef NodeType Node;
+    typedef BasicEdgeList<Node> EdgeList;
+    typedef BasicCliqueMembership<Node> CliqueMembership;
+    typedef typename EdgeKey<Node>::type Key;
+    typedef BasicEdgeMultiset<Key> EdgeMultiset;
+
+    BasicClusteredGraphSampler(
+            std::vector<unsigned int> membership_sequence,
+            std::vector<unsigned int> clique_size_sequence,
+            unsigned int seed);
+
+    //graph generation methods
+    std::pair<EdgeList,CliqueMembership> get_graph(unsigned int step);
+    //projected edges (added, removed) since the last sample
+    std::pair<EdgeList,EdgeList> get_edge_delta(unsigned int step);
+
+    //accessors
+    std::size_t number_of_nodes() const
+        {return membership_sequence_.size();}
+    std::size_t number_of_edges() const
+        {return edge_count_.size();}
+
+private:
+    void membership_swap();
+    void replace_member(std::size_t c, Node old_member, Node new_member);
+    void project(std::size_t c, Node member, bool add);
+    void compact_delta();
+    //members
+    RNGType gen_;
+    std::vector<unsigned int> membership_sequence_;
+    CliqueMembership membership_;
+    std::vector<Node> clique_of_stub_;
+    //number of cliques joining each pair, packed with the smaller node first
+    EdgeMultiset edge_count_;
+    std::vector<Key> added_edges_;
+    std::vector<Key> removed_edges_;
+    std::size_t compacted_size_;
+};
+
 /*
  * Generation of unclustered segregated networks using the same membership and
  * clique size sequence as for the clustered graph generator
  */
-class SegregatedGraphGenerator
+template<typename NodeType>
+class BasicSegregatedGraphGenerator
 {
 public:
-    SegregatedGraphGenerator(
-            const std::vector<unsigned int>& membership_sequence,
-            const std::vector<unsigned int>& clique_size_sequence,
+    typedef NodeType Node;
+    typedef BasicEdgeList<Node> EdgeList;
+    typedef BasicEdgeSet<Node> EdgeSet;
+    typedef BasicCliqueMembership<Node> CliqueMembership;
+
+    BasicSegregatedGraphGenerator(
+            std::vector<unsigned int> membership_sequence,
+            std::vector<unsigned int> clique_size_sequence,
             unsigned int seed);
 
     //graph generation methods
     std::pair<EdgeList,std::vector<std::set<Node>>> get_graph();
     std::pair<EdgeList,std::vector<std::vector<Node>>> get_multigraph();
 
+    //graph generation methods with flat clique membership
+    std::pair<EdgeList,CliqueMembership> get_graph_flat();
+    std::pair<EdgeList,CliqueMembership> get_multigraph_flat();
+
+    //accessors
+    std::size_t number_of_nodes() const
+        {return membership_sequence_.size();}
+
 private:
     RNGType gen_;
     std::vector<unsigned int> membership_sequence_;
     std::vector<unsigned int> clique_size_sequence_;
-    std::vector<unsigned int> clique_stub_vector_;
+    std::vector<Node> clique_stub_vector_;
     std::vector<Node> node_stub_vector_;
 };
 
 
+/*
+ * Generation of Chung-Lu graphs with a given expected degree sequence. Nodes
+ * are sorted by decreasing weight and the candidate neighbors of each node
+ * are skipped geometrically (Miller and Hagberg), in O(N+E).
+ */
+template<typename NodeType>
+class BasicChungLuGenerator
+{
+public:
+    typedef NodeType Node;
+    typedef BasicEdgeList<Node> EdgeList;
+
+    BasicChungLuGenerator(
+            const std::vector<double>& weight_sequence,
+            unsigned int seed);
+
+    //graph generation methods
+    EdgeList get_graph();
+
+    //accessors
+    std::size_t number_of_nodes() const
+        {return order_.size();}
+
+private:
+    RNGType gen_;
+    double total_weight_;
+    std::vector<double> sorted_weights_;
+    std::vector<Node> order_;
+};
+
+//generators with 32 bits node indices
+typedef BasicConfigurationModelGenerator<uint32_t>
+    ConfigurationModelGenerator;
+typedef BasicDirectedConfigurationModelGenerator<uint32_t>
+    DirectedConfigurationModelGenerator;
+typedef BasicBipartiteConfigurationModelGenerator<uint32_t>
+    BipartiteConfigurationModelGenerator;
+typedef BasicConfigurationModelSampler<uint32_t> ConfigurationModelSampler;
+typedef BasicCurveballSampler<uint32_t> CurveballSampler;
+typedef BasicClusteredGraphGenerator<uint32_t> ClusteredGraphGenerator;
+typedef BasicClusteredGraphSampler<uint32_t> ClusteredGraphSampler;
+typedef BasicSegregatedGraphGenerator<uint32_t> SegregatedGraphGenerator;
+typedef BasicChungLuGenerator<uint32_t> ChungLuGenerator;
+typedef BasicJointDegreeGenerator<uint32_t> JointDegreeGenerator;
+
+//generators with 64 bits node indices, for more than 2^32 nodes
+typedef BasicConfigurationModelGenerator<uint64_t>
+    ConfigurationModelGenerator64;
+typedef BasicDirectedConfigurationModelGenerator<uint64_t>
+    DirectedConfigurationModelGenerator64;
+typedef BasicBipartiteConfigurationModelGenerator<uint64_t>
+    BipartiteConfigurationModelGenerator64;
+typedef BasicConfigurationModelSampler<uint64_t> ConfigurationModelSampler64;
+typedef BasicCurveballSampler<uint64_t> CurveballSampler64;
+typedef BasicClusteredGraphGenerator<uint64_t> ClusteredGraphGenerator64;
+typedef BasicClusteredGraphSampler<uint64_t> ClusteredGraphSampler64;
+typedef BasicSegregatedGraphGenerator<uint64_t> SegregatedGraphGenerator64;
+typedef BasicChungLuGenerator<uint64_t> ChungLuGenerator64;
+typedef BasicJointDegreeGenerator<uint64_t> JointDegreeGenerator64;
+
+
 /* ==========================
  *     Utility functions
  * ==========================*/
-inline unsigned int random_int(std::size_t size, RNGType& gen)
+inline std::size_t random_int(std::size_t size, RNGType& gen)
 {
     return floor(std::generate_canonical<double,
         std::numeric_limits<double>::digits>(gen)*size);
@@ -160,9 +896,450 @@ inline double random_01(RNGType& gen)
         std::numeric_limits<double>::digits>(gen);
 }
 
+//64 bits seed of the RNG streams, the two draws are sequenced so the seed
+//does not depend on the compiler
+inline uint64_t draw_seed(RNGType& gen)
+{
+    uint64_t high = gen();
+    uint64_t low = gen();
+    return (high << 32) | low;
+}
+
+//vector where each index i is repeated sequence[i] times
+template<typename NodeType = Node>
+std::vector<NodeType> stub_vector(const std::vector<unsigned int>& sequence)
+{
+    std::vector<NodeType> stubs;
+    stubs.reserve(std::accumulate(sequence.begin(), sequence.end(),
+                std::size_t(0)));
+    for (NodeType i = 0; i < sequence.size(); i++)
+    {
+        stubs.insert(stubs.end(), sequence[i], i);
+    }
+    return stubs;
+}
+
+//group the node stubs by clique, node_stub_vector[i] is a member of the
+//clique clique_stub_vector[i]
+template<typename NodeType>
+BasicCliqueMembership<NodeType> clique_membership(
+        const std::vector<unsigned int>& clique_size_sequence,
+        const std::vector<NodeType>& clique_stub_vector,
+        const std::vector<NodeType>& node_stub_vector)
+{
+    BasicCliqueMembership<NodeType> membership;
+    membership.offsets.resize(clique_size_sequence.size()+1);
+    membership.offsets[0] = 0;
+    for (std::size_t c = 0; c < clique_size_sequence.size(); c++)
+    {
+        membership.offsets[c+1] = membership.offsets[c] +
+            clique_size_sequence[c];
+    }
+    membership.members.resize(node_stub_vector.size());
+    std::vector<std::size_t> position(membership.offsets.begin(),
+            membership.offsets.end()-1);
+    for (std::size_t i = 0; i < clique_stub_vector.size(); i++)
+    {
+        membership.members[position[clique_stub_vector[i]]++] =
+            node_stub_vector[i];
+    }
+    return membership;
+}
+
+//sort the members of each clique and remove the repeated members
+template<typename NodeType>
+void remove_repeated_members(BasicCliqueMembership<NodeType>& membership)
+{
+    std::size_t size = 0;
+    for (std::size_t c = 0; c+1 < membership.offsets.size(); c++)
+    {
+        auto first = membership.members.begin() + membership.offsets[c];
+        auto last = membership.members.begin() + membership.offsets[c+1];
+        std::sort(first, last);
+        last = std::unique(first, last);
+        membership.offsets[c] = size;
+        size = std::copy(first, last, membership.members.begin() + size) -
+            membership.members.begin();
+    }
+    membership.offsets.back() = size;
+    membership.members.resize(size);
+}
+
+//clique membership as a vector of sets
+template<typename NodeType>
+std::vector<std::set<NodeType>> clique_sets(
+        const BasicCliqueMembership<NodeType>& membership)
+{
+    std::vector<std::set<NodeType>> clique_vector;
+    clique_vector.reserve(membership.offsets.size()-1);
+    for (std::size_t c = 0; c+1 < membership.offsets.size(); c++)
+    {
+        clique_vector.emplace_back(
+                membership.members.begin() + membership.offsets[c],
+                membership.members.begin() + membership.offsets[c+1]);
+    }
+    return clique_vector;
+}
+
+//clique membership as a vector of vectors
+template<typename NodeType>
+std::vector<std::vector<NodeType>> clique_vectors(
+        const BasicCliqueMembership<NodeType>& membership)
+{
+    std::vector<std::vector<NodeType>> clique_vector;
+    clique_vector.reserve(membership.offsets.size()-1);
+    for (std::size_t c = 0; c+1 < membership.offsets.size(); c++)
+    {
+        clique_vector.emplace_back(
+                membership.members.begin() + membership.offsets[c],
+                membership.members.begin() + membership.offsets[c+1]);
+    }
+    return clique_vector;
+}
+
+//number of threads to use, 0 means all the hardware threads
+inline unsigned int thread_count(unsigned int n_threads)
+{
+    if (n_threads == 0)
+        n_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    return n_threads;
+}
+
+//split [0,n) in n_threads contiguous blocks and call f(begin,end) on each
+//block in its own thread; n_threads = 0 uses all the hardware threads
+template<typename Function>
+void parallel_for(std::size_t n, unsigned int n_threads, Function f)
+{
+    n_threads = thread_count(n_threads);
+    if (n_threads > n)
+        n_threads = std::max(n, std::size_t(1));
+    if (n_threads == 1)
+    {
+        f(std::size_t(0), n);
+        return;
+    }
+    std::vector<std::thread> threads;
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    for (unsigned int t = 0; t < n_threads; t++)
+    {
+        threads.emplace_back([&, t]()
+                {
+                    try
+                    {
+                        f(n*t/n_threads, n*(t+1)/n_threads);
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard<std::mutex> lock(error_mutex);
+                        error = std::current_exception();
+                    }
+                });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    if (error)
+        std::rethrow_exception(error);
+}
+
+//write the stub vector of a sequence in stubs, the nodes are split in
+//n_threads blocks whose stubs are written in parallel
+template<typename NodeType>
+void fill_stubs(const std::vector<unsigned int>& sequence, NodeType* stubs,
+        unsigned int n_threads)
+{
+    std::size_t n_blocks = thread_count(n_threads);
+    std::size_t N = sequence.size();
+    std::vector<std::size_t> block_offset(n_blocks+1, 0);
+    parallel_for(n_blocks, n_threads, [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t b = begin; b < end; b++)
+                {
+                    block_offset[b+1] = std::accumulate(
+                            sequence.begin() + N*b/n_blocks,
+                            sequence.begin() + N*(b+1)/n_blocks,
+                            std::size_t(0));
+                }
+            });
+    std::partial_sum(block_offset.begin(), block_offset.end(),
+            block_offset.begin());
+    parallel_for(n_blocks, n_threads, [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t b = begin; b < end; b++)
+                {
+                    NodeType* position = stubs + block_offset[b];
+                    for (std::size_t i = N*b/n_blocks; i < N*(b+1)/n_blocks;
+                            i++)
+                    {
+                        position = std::fill_n(position, sequence[i],
+                                NodeType(i));
+                    }
+                }
+            });
+}
+
+//write a random permutation of input[0], ..., input[n-1] in output. Each
+//element is sent to a uniformly random bucket, then each bucket is shuffled,
+//which gives a uniform permutation. The blocks of input and the buckets use
+//their own RNG streams, so the result does not depend on n_threads.
+template<typename T>
+void parallel_shuffle(const T* input, T* output, std::size_t n, RNGType& gen,
+        unsigned int n_threads)
+{
+    const std::size_t block_size = 1 << 22;
+    std::size_t n_blocks = (n + block_size - 1)/block_size;
+    uint32_t n_buckets = std::max(n_blocks, std::size_t(1));
+    uint64_t seed = draw_seed(gen);
+
+    //count[b*n_buckets+c] is the number of elements of block b sent to bucket
+    //c, the bucket of each element is drawn again when it is moved
+    std::vector<std::size_t> count(n_blocks*n_buckets, 0);
+    parallel_for(n_blocks, n_threads, [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t b = begin; b < end; b++)
+                {
+                    RNGType block_gen(seed, b);
+                    std::size_t last = std::min(n, (b+1)*block_size);
+                    for (std::size_t i = b*block_size; i < last; i++)
+                    {
+                        count[b*n_buckets + block_gen(n_buckets)] += 1;
+                    }
+                }
+            });
+
+    //position of the first element of block b in bucket c, the buckets are
+    //contiguous and ordered by block
+    std::vector<std::size_t> bucket_offset(n_buckets+1, 0);
+    std::vector<std::size_t> position(n_blocks*n_buckets);
+    std::size_t total = 0;
+    for (uint32_t c = 0; c < n_buckets; c++)
+    {
+        bucket_offset[c] = total;
+        for (std::size_t b = 0; b < n_blocks; b++)
+        {
+            position[b*n_buckets + c] = total;
+            total += count[b*n_buckets + c];
+        }
+    }
+    bucket_offset[n_buckets] = total;
+
+    parallel_for(n_blocks, n_threads, [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t b = begin; b < end; b++)
+                {
+                    RNGType block_gen(seed, b);
+                    std::size_t last = std::min(n, (b+1)*block_size);
+                    for (std::size_t i = b*block_size; i < last; i++)
+                    {
+                        output[position[b*n_buckets + block_gen(n_buckets)]++]
+                            = input[i];
+                    }
+                }
+            });
+
+    parallel_for(n_buckets, n_threads, [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t c = begin; c < end; c++)
+                {
+                    RNGType bucket_gen(seed, n_blocks + c);
+                    std::shuffle(output + bucket_offset[c],
+                            output + bucket_offset[c+1], bucket_gen);
+                }
+            });
+}
+
+//sort unsigned keys with a LSD radix sort on bytes, skipping the bytes that
+//are the same for every key
+template<typename Key>
+void radix_sort(std::vector<Key>& keys)
+{
+    if (keys.size() < 2)
+        return;
+    std::vector<Key> buffer(keys.size());
+    for (unsigned int shift = 0; shift < 8*sizeof(Key); shift += 8)
+    {
+        std::size_t count[257] = {0};
+        for (const Key& key : keys)
+        {
+            count[static_cast<std::size_t>((key >> shift) & 0xFF) + 1] += 1;
+        }
+        if (count[static_cast<std::size_t>((keys[0] >> shift) & 0xFF) + 1] ==
+                keys.size())
+        {
+            continue;
+        }
+        std::partial_sum(count, count + 257, count);
+        for (const Key& key : keys)
+        {
+            buffer[count[static_cast<std::size_t>((key >> shift) & 0xFF)]++] =
+                key;
+        }
+        keys.swap(buffer);
+    }
+}
+
+//radix sort with the keys split in n_threads blocks; each pass counts the
+//bytes of the blocks in parallel, then scatters them in parallel at the
+//positions given by the prefix sums in (byte, block) order
+template<typename Key>
+void parallel_radix_sort(std::vector<Key>& keys, unsigned int n_threads)
+{
+    n_threads = thread_count(n_threads);
+    const std::size_t n = keys.size();
+    if (n_threads == 1 or n < (std::size_t(1) << 16))
+    {
+        radix_sort(keys);
+        return;
+    }
+    std::vector<Key> buffer(n);
+    std::vector<std::size_t> count(256*n_threads);
+    for (unsigned int shift = 0; shift < 8*sizeof(Key); shift += 8)
+    {
+        auto byte = [shift](const Key& key)
+            {
+                return static_cast<std::size_t>((key >> shift) & 0xFF);
+            };
+        std::fill(count.begin(), count.end(), 0);
+        parallel_for(n_threads, n_threads, [&](std::size_t begin,
+                    std::size_t end)
+                {
+                    for (std::size_t t = begin; t < end; t++)
+                    {
+                        std::size_t* block_count = &count[256*t];
+                        for (std::size_t i = n*t/n_threads;
+                                i < n*(t+1)/n_threads; i++)
+                        {
+                            block_count[byte(keys[i])] += 1;
+                        }
+                    }
+                });
+        std::size_t first_byte_count = 0;
+        for (unsigned int t = 0; t < n_threads; t++)
+        {
+            first_byte_count += count[256*t + byte(keys[0])];
+        }
+        if (first_byte_count == n)
+            continue;
+        std::size_t position = 0;
+        for (std::size_t b = 0; b < 256; b++)
+        {
+            for (unsigned int t = 0; t < n_threads; t++)
+            {
+                std::size_t block_count = count[256*t + b];
+                count[256*t + b] = position;
+                position += block_count;
+            }
+        }
+        parallel_for(n_threads, n_threads, [&](std::size_t begin,
+                    std::size_t end)
+                {
+                    for (std::size_t t = begin; t < end; t++)
+                    {
+                        std::size_t* block_position = &count[256*t];
+                        for (std::size_t i = n*t/n_threads;
+                                i < n*(t+1)/n_threads; i++)
+                        {
+                            buffer[block_position[byte(keys[i])]++] = keys[i];
+                        }
+                    }
+                });
+        keys.swap(buffer);
+    }
+}
+
+//concatenate a vector of edge lists, offsets[i] is the position of the first
+//edge of edge_list_vector[i]
+template<typename NodeType>
+std::pair<BasicEdgeList<NodeType>,std::vector<std::size_t>> concatenate(
+        std::vector<BasicEdgeList<NodeType>>& edge_list_vector)
+{
+    typedef BasicEdgeList<NodeType> EdgeList;
+    std::vector<std::size_t> offsets(edge_list_vector.size()+1, 0);
+    for (std::size_t i = 0; i < edge_list_vector.size(); i++)
+    {
+        offsets[i+1] = offsets[i] + edge_list_vector[i].size();
+    }
+    EdgeList edge_list;
+    edge_list.reserve(offsets.back());
+    for (auto& realization : edge_list_vector)
+    {
+        edge_list.insert(edge_list.end(), realization.begin(),
+                realization.end());
+        EdgeList().swap(realization);
+    }
+    return std::make_pair(std::move(edge_list), std::move(offsets));
+}
+
+//fill the CSR adjacency of an edge list; on entry indptr[i+1] must contain
+//the position of the first neighbor of i, on exit it contains the position
+//past its last neighbor. Directed edges are only stored from their source.
+template<typename NodeType>
+void fill_csr(BasicCSRGraph<NodeType>& csr,
+        const BasicEdgeList<NodeType>& edge_list, bool directed)
+{
+    for (auto& edge : edge_list)
+    {
+        csr.indices[csr.indptr[edge.first+1]++] = edge.second;
+        if (not directed)
+            csr.indices[csr.indptr[edge.second+1]++] = edge.first;
+    }
+}
+
+//CSR adjacency of an edge list, built with a counting pass
+template<typename NodeType>
+BasicCSRGraph<NodeType> edge_list_to_csr(
+        const BasicEdgeList<NodeType>& edge_list,
+        std::size_t number_of_nodes, bool directed = false)
+{
+    BasicCSRGraph<NodeType> csr;
+    csr.indptr.assign(number_of_nodes+1, 0);
+    for (auto& edge : edge_list)
+    {
+        csr.indptr[edge.first+1] += 1;
+        if (not directed)
+            csr.indptr[edge.second+1] += 1;
+    }
+    std::size_t position = 0;
+    for (std::size_t i = 1; i <= number_of_nodes; i++)
+    {
+        std::size_t degree = csr.indptr[i];
+        csr.indptr[i] = position;
+        position += degree;
+    }
+    csr.indices.resize(position);
+    fill_csr(csr, edge_list, directed);
+    return csr;
+}
+
+//CSR adjacency of an edge list, sized from its degree sequence (out-degree
+//sequence if directed)
+template<typename NodeType>
+BasicCSRGraph<NodeType> edge_list_to_csr(
+        const BasicEdgeList<NodeType>& edge_list,
+        const std::vector<unsigned int>& degree_sequence,
+        bool directed = false)
+{
+    BasicCSRGraph<NodeType> csr;
+    csr.indptr.resize(degree_sequence.size()+1);
+    std::size_t position = 0;
+    csr.indptr[0] = 0;
+    for (std::size_t i = 1; i <= degree_sequence.size(); i++)
+    {
+        csr.indptr[i] = position;
+        position += degree_sequence[i-1];
+    }
+    csr.indices.resize(position);
+    fill_csr(csr, edge_list, directed);
+    return csr;
+}
+
 //randomly match nodes as in an ER network
-inline void random_matching(EdgeSet& edge_set, std::vector<Node>& node_vector,
-        double edge_probability, RNGType& gen)
+template<typename NodeType>
+void random_matching(BasicEdgeSet<NodeType>& edge_set,
+        std::vector<NodeType>& node_vector, double edge_probability,
+        RNGType& gen)
 {
     size_t N = node_vector.size();
     for (size_t i = 0; i < N - 1; i++)
@@ -193,6 +1370,31 @@ inline void random_matching(EdgeSet& edge_set, std::vector<Node>& node_vector,
     }
 }
 
+/* ==========================
+ *   Simple graph repair
+ * ==========================*/
+//Erdos-Gallai test of the existence of a simple graph, in O(N)
+bool is_graphical(const std::vector<unsigned int>& degree_sequence);
+//Fulkerson-Chen-Anstee test of the existence of a simple directed graph, in
+//O(N log N)
+bool is_digraphical(const std::vector<unsigned int>& in_degree_sequence,
+        const std::vector<unsigned int>& out_degree_sequence);
+
+//Gale-Ryser test of the existence of a simple bipartite graph, in O(N+M)
+bool is_bigraphical(const std::vector<unsigned int>& membership_sequence,
+        const std::vector<unsigned int>& clique_size_sequence);
+
+//rewire the self-loops and multiedges until the graph is simple, or until
+//max_rewiring rewirings or max_seconds are spent (0 means no limit). Directed
+//and bipartite edges are rewired by exchanging their second element.
+template<typename NodeType>
+RepairStatus rewire_faulty_edges(BasicEdgeList<NodeType>& edge_list,
+        RNGType& gen, std::size_t max_rewiring = 0, double max_seconds = 0,
+        EdgeType edge_type = EdgeType::UNDIRECTED);
+template<typename NodeType>
+void rewire_faulty_edges_sorted(BasicEdgeList<NodeType>& edge_list,
+        RNGType& gen);
+
 }//end of namespace rggen
 
 #endif /* GRAPH_GENERATOR_HPP_ */
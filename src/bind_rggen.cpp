@@ -24,17 +24,330 @@
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/numpy.h>
 #include "GraphGenerator.hpp"
+#include <cstring>
 
 using namespace std;
 using namespace rggen;
 
 namespace py = pybind11;
 
+/* ==========================
+ *     Output conversion
+ * ==========================*/
+enum class OutputFormat {LIST, ARRAY, CSR};
 
-PYBIND11_MODULE(_rggen, m)
+OutputFormat parse_output(const string& output)
+{
+    if (output == "list")
+        return OutputFormat::LIST;
+    if (output == "array")
+        return OutputFormat::ARRAY;
+    if (output == "csr")
+        return OutputFormat::CSR;
+    throw py::value_error("output must be 'list', 'array' or 'csr'");
+}
+
+//hand over an edge list to numpy without copy, the array owns the vector
+template<typename NodeType>
+py::array_t<NodeType> edge_array(BasicEdgeList<NodeType>&& edge_list)
+{
+    typedef BasicEdgeList<NodeType> EdgeList;
+    static_assert(sizeof(BasicEdge<NodeType>) == 2*sizeof(NodeType) and
+            is_standard_layout<BasicEdge<NodeType>>::value,
+            "Edge must be two contiguous Node");
+    EdgeList* owner = new EdgeList(move(edge_list));
+    py::capsule base(owner, [](void* ptr)
+            {
+                delete static_cast<EdgeList*>(ptr);
+            });
+    return py::array_t<NodeType>({owner->size(), static_cast<size_t>(2)},
+            {sizeof(BasicEdge<NodeType>), sizeof(NodeType)},
+            reinterpret_cast<const NodeType*>(owner->data()), base);
+}
+
+//hand over a vector to numpy without copy, the array owns the vector
+template<typename T>
+py::array_t<T> vector_array(vector<T>&& vec)
+{
+    vector<T>* owner = new vector<T>(move(vec));
+    py::capsule base(owner, [](void* ptr)
+            {
+                delete static_cast<vector<T>*>(ptr);
+            });
+    return py::array_t<T>(static_cast<py::ssize_t>(owner->size()),
+            owner->data(), base);
+}
+
+//(indptr, indices) arrays of a CSR adjacency
+template<typename NodeType>
+py::tuple csr_output(BasicCSRGraph<NodeType>&& csr)
+{
+    return py::make_tuple(vector_array(move(csr.indptr)),
+            vector_array(move(csr.indices)));
+}
+
+template<typename NodeType>
+py::object edge_output(BasicEdgeList<NodeType>&& edge_list,
+        OutputFormat format, size_t number_of_nodes)
+{
+    if (format == OutputFormat::ARRAY)
+        return edge_array(move(edge_list));
+    if (format == OutputFormat::CSR)
+    {
+        BasicCSRGraph<NodeType> csr;
+        {
+            py::gil_scoped_release release;
+            csr = edge_list_to_csr(edge_list, number_of_nodes);
+            BasicEdgeList<NodeType>().swap(edge_list);
+        }
+        return csr_output(move(csr));
+    }
+    return py::cast(edge_list);
+}
+
+enum class CliqueFormat {LIST, FLAT};
+
+CliqueFormat parse_clique_output(const string& clique_output)
 {
-    py::class_<ConfigurationModelGenerator>(m, "ConfigurationModelGenerator")
+    if (clique_output == "list")
+        return CliqueFormat::LIST;
+    if (clique_output == "flat")
+        return CliqueFormat::FLAT;
+    throw py::value_error("clique_output must be 'list' or 'flat'");
+}
+
+//clique membership as a list of sets (or lists) or as flat arrays
+template<typename NodeType>
+py::object membership_output(BasicCliqueMembership<NodeType>&& membership,
+        CliqueFormat format, bool as_set)
+{
+    if (format == CliqueFormat::FLAT)
+    {
+        return py::make_tuple(vector_array(move(membership.offsets)),
+                vector_array(move(membership.members)));
+    }
+    py::list clique_list;
+    for (size_t c = 0; c+1 < membership.offsets.size(); c++)
+    {
+        auto first = membership.members.begin() + membership.offsets[c];
+        auto last = membership.members.begin() + membership.offsets[c+1];
+        py::list clique(last - first);
+        for (size_t i = 0; first + i != last; i++)
+        {
+            clique[i] = py::int_(first[i]);
+        }
+        if (as_set)
+            clique_list.append(py::set(clique));
+        else
+            clique_list.append(clique);
+    }
+    return clique_list;
+}
+
+/* ==========================
+ *     Input conversion
+ * ==========================*/
+
+//read the element i of a strided buffer, checking that it fits in the
+//unsigned output type U
+template<typename U, typename T>
+U buffer_value(const py::buffer_info& info, const char* name,
+        py::ssize_t i, py::ssize_t j = 0)
+{
+    const char* ptr = static_cast<const char*>(info.ptr) + i*info.strides[0];
+    if (info.ndim > 1)
+        ptr += j*info.strides[1];
+    T value = *reinterpret_cast<const T*>(ptr);
+    if (value < 0 or static_cast<unsigned long long>(value) >
+            numeric_limits<U>::max())
+    {
+        throw py::value_error(string(name) + " contains a value out of "
+                "the range of " + to_string(8*sizeof(U)) +
+                " bits unsigned integers");
+    }
+    return static_cast<U>(value);
+}
+
+//copy a 1d or 2d integer buffer (int32, int64, uint32 or uint64) in a single
+//bounds-checked pass, the buffer is read in row-major order
+template<typename T, typename U>
+void read_typed_buffer(const py::buffer_info& info, const char* name,
+        U* output)
+{
+    py::ssize_t columns = info.ndim > 1 ? info.shape[1] : 1;
+    for (py::ssize_t i = 0; i < info.shape[0]; i++)
+    {
+        for (py::ssize_t j = 0; j < columns; j++)
+        {
+            *output++ = buffer_value<U,T>(info, name, i, j);
+        }
+    }
+}
+
+//format character of a native byte order buffer, the byte order character
+//is skipped
+string buffer_format(const py::buffer_info& info)
+{
+    string format = info.format;
+    if (not format.empty() and string("@=<").find(format[0]) != string::npos)
+        format.erase(0,1);
+    return format;
+}
+
+template<typename U>
+void read_buffer(const py::buffer_info& info, const char* name, U* output)
+{
+    string format = buffer_format(info);
+    bool is_signed = format == "i" or format == "l" or format == "q";
+    bool is_unsigned = format == "I" or format == "L" or format == "Q";
+    if (is_signed and info.itemsize == 4)
+        read_typed_buffer<int32_t>(info, name, output);
+    else if (is_signed and info.itemsize == 8)
+        read_typed_buffer<int64_t>(info, name, output);
+    else if (is_unsigned and info.itemsize == 4)
+        read_typed_buffer<uint32_t>(info, name, output);
+    else if (is_unsigned and info.itemsize == 8)
+        read_typed_buffer<uint64_t>(info, name, output);
+    else
+        throw py::type_error(string(name) + " must be an array of int32, "
+                "int64, uint32 or uint64");
+}
+
+//sequence of integers from a 1d buffer
+vector<unsigned int> sequence_from_buffer(const py::buffer& buffer,
+        const char* name)
+{
+    py::buffer_info info = buffer.request();
+    if (info.ndim != 1)
+        throw py::value_error(string(name) + " must be one-dimensional");
+    vector<unsigned int> sequence(info.shape[0]);
+    read_buffer(info, name, sequence.data());
+    return sequence;
+}
+
+//edge list from a (E,2) buffer
+template<typename NodeType>
+BasicEdgeList<NodeType> edge_list_from_buffer(const py::buffer& buffer,
+        const char* name)
+{
+    py::buffer_info info = buffer.request();
+    if (info.ndim != 2 or info.shape[1] != 2)
+        throw py::value_error(string(name) + " must be of shape (E,2)");
+    vector<NodeType> nodes(2*info.shape[0]);
+    read_buffer(info, name, nodes.data());
+    BasicEdgeList<NodeType> edge_list(info.shape[0]);
+    for (size_t i = 0; i < edge_list.size(); i++)
+    {
+        edge_list[i] = BasicEdge<NodeType>(nodes[2*i], nodes[2*i+1]);
+    }
+    return edge_list;
+}
+
+
+//joint degree matrix from a (M,3) buffer whose rows are (k, l, count)
+JointDegreeMatrix joint_degree_matrix_from_buffer(const py::buffer& buffer,
+        const char* name)
+{
+    py::buffer_info info = buffer.request();
+    if (info.ndim != 2 or info.shape[1] != 3)
+        throw py::value_error(string(name) + " must be of shape (M,3)");
+    vector<uint64_t> entries(3*info.shape[0]);
+    read_buffer(info, name, entries.data());
+    JointDegreeMatrix joint_degree_matrix;
+    joint_degree_matrix.reserve(info.shape[0]);
+    for (size_t i = 0; i < entries.size(); i += 3)
+    {
+        if (max(entries[i], entries[i+1]) > numeric_limits<unsigned int>::max())
+        {
+            throw py::value_error(string(name) + " contains a degree out of "
+                    "the range of unsigned int");
+        }
+        joint_degree_matrix.emplace_back(entries[i], entries[i+1],
+                entries[i+2]);
+    }
+    return joint_degree_matrix;
+}
+
+//writable (n,E,2) C-contiguous block of node indices, allocated if out is None
+template<typename NodeType>
+py::object sample_block(py::object out, size_t n, size_t n_edges,
+        NodeType*& block)
+{
+    if (out.is_none())
+    {
+        out = py::array_t<NodeType>(vector<py::ssize_t>{py::ssize_t(n),
+                py::ssize_t(n_edges), 2});
+    }
+    py::buffer_info info = py::buffer(out).request(true);
+    string format = buffer_format(info);
+    bool is_unsigned = format == "I" or format == "L" or format == "Q";
+    if (not is_unsigned or info.itemsize != sizeof(NodeType))
+    {
+        throw py::type_error("out must be an array of uint"
+                + to_string(8*sizeof(NodeType)));
+    }
+    if (info.ndim != 3 or size_t(info.shape[0]) != n or
+            size_t(info.shape[1]) != n_edges or info.shape[2] != 2)
+    {
+        throw py::value_error("out must be of shape (n,E,2)");
+    }
+    if (info.strides[2] != info.itemsize or
+            info.strides[1] != 2*info.itemsize or
+            info.strides[0] != py::ssize_t(2*n_edges)*info.itemsize)
+    {
+        throw py::value_error("out must be C-contiguous");
+    }
+    block = static_cast<NodeType*>(info.ptr);
+    return out;
+}
+
+/* ==========================
+ *     Class bindings
+ * ==========================*/
+
+//bind the generators with node indices of type NodeType, the class names
+//are suffixed with the number of bits of the indices
+template<typename NodeType>
+void bind_generators(py::module& m, const string& suffix)
+{
+    typedef BasicEdgeList<NodeType> EdgeList;
+    typedef BasicEdgeTriplet<NodeType> EdgeTriplet;
+    typedef BasicCSRGraph<NodeType> CSRGraph;
+    typedef BasicCliqueMembership<NodeType> CliqueMembership;
+    typedef BasicEdgeCounts<NodeType> EdgeCounts;
+    typedef BasicConfigurationModelGenerator<NodeType>
+        ConfigurationModelGenerator;
+    typedef BasicDirectedConfigurationModelGenerator<NodeType>
+        DirectedConfigurationModelGenerator;
+    typedef BasicBipartiteConfigurationModelGenerator<NodeType>
+        BipartiteConfigurationModelGenerator;
+    typedef BasicConfigurationModelSampler<NodeType>
+        ConfigurationModelSampler;
+    typedef BasicCurveballSampler<NodeType> CurveballSampler;
+    typedef BasicClusteredGraphGenerator<NodeType> ClusteredGraphGenerator;
+    typedef BasicClusteredGraphSampler<NodeType> ClusteredGraphSampler;
+    typedef BasicSegregatedGraphGenerator<NodeType> SegregatedGraphGenerator;
+    typedef BasicChungLuGenerator<NodeType> ChungLuGenerator;
+    typedef BasicJointDegreeGenerator<NodeType> JointDegreeGenerator;
+
+    py::class_<ConfigurationModelGenerator>(m,
+            ("ConfigurationModelGenerator" + suffix).c_str())
+
+        .def(py::init([](const py::buffer& degree_sequence, unsigned int seed)
+                {
+                    return new ConfigurationModelGenerator(
+                            sequence_from_buffer(degree_sequence,
+                                "degree_sequence"), seed);
+                }), R"pbdoc(
+            Constructor of the class ConfigurationModelGenerator from an
+            integer array (int32, int64, uint32 or uint64)
+
+            Args:
+               degree_sequence: Array of degree for the network
+               seed: Seed for the RNG.
+            )pbdoc", py::arg("degree_sequence"), py::arg("seed") = 42)
 
         .def(py::init<vector<unsigned int>, unsigned int >(), R"pbdoc(
             Default constructor of the class ConfigurationModelGenerator
@@ -44,16 +357,447 @@ PYBIND11_MODULE(_rggen, m)
                seed: Seed for the RNG.
             )pbdoc", py::arg("degree_sequence"), py::arg("seed") = 42)
 
-        .def("get_graph", &ConfigurationModelGenerator::get_graph,
-                R"pbdoc(
+        .def("get_graph", [](ConfigurationModelGenerator& self,
+                    bool simple_graph, const string& output,
+                    unsigned int n_threads)
+                {
+                    OutputFormat format = parse_output(output);
+                    if (format == OutputFormat::CSR)
+                    {
+                        CSRGraph csr;
+                        {
+                            py::gil_scoped_release release;
+                            csr = self.get_graph_csr(simple_graph,
+                                    n_threads);
+                        }
+                        return py::object(csr_output(move(csr)));
+                    }
+                    EdgeList edge_list;
+                    {
+                        py::gil_scoped_release release;
+                        edge_list = self.get_graph(simple_graph,
+                                n_threads);
+                    }
+                    return edge_output(move(edge_list), format,
+                            self.number_of_nodes());
+                }, R"pbdoc(
             Create a random edge list from the configuration model.
 
             Args:
                simple_graph: bool indicating if the network must be a
                simple graph
-            )pbdoc", py::arg("simple_graph") = false);
+               output: 'list' for a list of tuples, 'array' for a (E,2)
+               numpy array sharing the memory of the generated edge list,
+               'csr' for the (indptr, indices) arrays of the adjacency
+               n_threads: Number of threads used to shuffle the stubs when
+               there are more than 1e9 stubs, 0 to use all the cores. The
+               result does not depend on the number of threads.
+            )pbdoc", py::arg("simple_graph") = false,
+                py::arg("output") = "list", py::arg("n_threads") = 1)
+
+        .def("set_repair_budget",
+                &ConfigurationModelGenerator::set_repair_budget, R"pbdoc(
+            Limit the rewiring of the multigraph into a simple graph. When
+            the budget is exhausted, get_graph returns the partially rewired
+            graph and status() is BUDGET_EXHAUSTED; get_graphs raises.
+
+            Args:
+               max_rewiring: Maximal number of rewirings, 0 for no limit
+               max_seconds: Maximal rewiring time in seconds, 0 for no limit
+            )pbdoc", py::arg("max_rewiring") = 0, py::arg("max_seconds") = 0.)
+
+        .def("status", &ConfigurationModelGenerator::status, R"pbdoc(
+            Status of the rewiring for the last simple graph generated.
+            )pbdoc")
+
+        .def("is_graphical", &ConfigurationModelGenerator::is_graphical,
+                R"pbdoc(
+            Whether the degree sequence admits a simple graph (Erdos-Gallai
+            test done at construction). get_graph(simple_graph=True) raises
+            if it does not.
+            )pbdoc")
+
+        .def("get_erased_graph", [](ConfigurationModelGenerator& self,
+                    const string& output, unsigned int n_threads)
+                {
+                    OutputFormat format = parse_output(output);
+                    pair<EdgeList,ErasedEdges> graph;
+                    {
+                        py::gil_scoped_release release;
+                        graph = self.get_erased_graph(n_threads);
+                    }
+                    return py::make_tuple(
+                            edge_output(move(graph.first), format,
+                                self.number_of_nodes()),
+                            graph.second.self_loops,
+                            graph.second.multiedges);
+                }, R"pbdoc(
+            Create a random edge list from the erased configuration model:
+            the self-loops and multiedges of a configuration model multigraph
+            are removed. The edges are sorted.
+
+            Args:
+               output: 'list' for a list of tuples, 'array' for a (E,2)
+               numpy array sharing the memory of the generated edge list,
+               'csr' for the (indptr, indices) arrays of the adjacency
+               n_threads: Number of threads used to shuffle the stubs when
+               there are more than 1e9 stubs, 0 to use all the cores.
+
+            Returns:
+               edges: Edge list of the erased graph
+               self_loops: Number of self-loops removed
+               multiedges: Number of repeated edges removed
+            )pbdoc", py::arg("output") = "list", py::arg("n_threads") = 1)
+
+        .def("get_graphs", [](const ConfigurationModelGenerator& self,
+                    size_t k, unsigned int n_threads, bool simple_graph)
+                {
+                    pair<EdgeList,vector<size_t>> graphs;
+                    {
+                        py::gil_scoped_release release;
+                        graphs = self.get_graphs(k, n_threads, simple_graph);
+                    }
+                    return py::make_tuple(edge_array(move(graphs.first)),
+                            vector_array(move(graphs.second)));
+                }, R"pbdoc(
+            Create k random edge lists from the configuration model in
+            parallel. The realization i uses the stream i of the RNG, the
+            result does not depend on the number of threads.
+
+            Args:
+               k: Number of realizations
+               n_threads: Number of threads, 0 to use all the cores
+               simple_graph: bool indicating if the networks must be
+               simple graphs
+
+            Returns:
+               edges: (E,2) array of the concatenated edge lists
+               offsets: array of size k+1, the edges of realization i are
+               edges[offsets[i]:offsets[i+1]]
+            )pbdoc", py::arg("k"), py::arg("n_threads") = 1,
+                py::arg("simple_graph") = false);
+
+    py::class_<DirectedConfigurationModelGenerator>(m,
+            ("DirectedConfigurationModelGenerator" + suffix).c_str())
+
+        .def(py::init([](const py::buffer& in_degree_sequence,
+                        const py::buffer& out_degree_sequence,
+                        unsigned int seed)
+                {
+                    return new DirectedConfigurationModelGenerator(
+                            sequence_from_buffer(in_degree_sequence,
+                                "in_degree_sequence"),
+                            sequence_from_buffer(out_degree_sequence,
+                                "out_degree_sequence"), seed);
+                }), R"pbdoc(
+            Constructor of the class DirectedConfigurationModelGenerator from
+            integer arrays (int32, int64, uint32 or uint64)
+
+            Args:
+               in_degree_sequence: Array of in-degree for the network
+               out_degree_sequence: Array of out-degree for the network
+               seed: Seed for the RNG.
+            )pbdoc", py::arg("in_degree_sequence"),
+                py::arg("out_degree_sequence"), py::arg("seed") = 42)
+
+        .def(py::init<vector<unsigned int>, vector<unsigned int>,
+                unsigned int>(), R"pbdoc(
+            Default constructor of the class
+            DirectedConfigurationModelGenerator
+
+            Args:
+               in_degree_sequence: Sequence of in-degree for the network
+               out_degree_sequence: Sequence of out-degree for the network
+               seed: Seed for the RNG.
+            )pbdoc", py::arg("in_degree_sequence"),
+                py::arg("out_degree_sequence"), py::arg("seed") = 42)
+
+        .def("get_graph", [](DirectedConfigurationModelGenerator& self,
+                    bool simple_graph, const string& output,
+                    unsigned int n_threads)
+                {
+                    OutputFormat format = parse_output(output);
+                    if (format == OutputFormat::CSR)
+                    {
+                        CSRGraph csr;
+                        {
+                            py::gil_scoped_release release;
+                            csr = self.get_graph_csr(simple_graph,
+                                    n_threads);
+                        }
+                        return py::object(csr_output(move(csr)));
+                    }
+                    EdgeList edge_list;
+                    {
+                        py::gil_scoped_release release;
+                        edge_list = self.get_graph(simple_graph,
+                                n_threads);
+                    }
+                    return edge_output(move(edge_list), format,
+                            self.number_of_nodes());
+                }, R"pbdoc(
+            Create a random list of directed edges (source, target) from the
+            directed configuration model.
+
+            Args:
+               simple_graph: bool indicating if the network must be a
+               simple directed graph (no self-loops nor repeated arcs)
+               output: 'list' for a list of tuples, 'array' for a (E,2)
+               numpy array sharing the memory of the generated edge list,
+               'csr' for the (indptr, indices) arrays of the out-adjacency
+               n_threads: Number of threads used to shuffle the stubs when
+               there are more than 1e9 stubs, 0 to use all the cores. The
+               result does not depend on the number of threads.
+            )pbdoc", py::arg("simple_graph") = false,
+                py::arg("output") = "list", py::arg("n_threads") = 1)
+
+        .def("set_repair_budget",
+                &DirectedConfigurationModelGenerator::set_repair_budget,
+                R"pbdoc(
+            Limit the rewiring of the multigraph into a simple directed
+            graph. When the budget is exhausted, get_graph returns the
+            partially rewired graph and status() is BUDGET_EXHAUSTED.
+
+            Args:
+               max_rewiring: Maximal number of rewirings, 0 for no limit
+               max_seconds: Maximal rewiring time in seconds, 0 for no limit
+            )pbdoc", py::arg("max_rewiring") = 0, py::arg("max_seconds") = 0.)
+
+        .def("status", &DirectedConfigurationModelGenerator::status,
+                R"pbdoc(
+            Status of the rewiring for the last simple graph generated.
+            )pbdoc")
+
+        .def("is_graphical",
+                &DirectedConfigurationModelGenerator::is_graphical, R"pbdoc(
+            Whether the degree sequences admit a simple directed graph
+            (Fulkerson-Chen-Anstee test done at construction).
+            get_graph(simple_graph=True) raises if they do not.
+            )pbdoc");
+
+    py::class_<BipartiteConfigurationModelGenerator>(m,
+            ("BipartiteConfigurationModelGenerator" + suffix).c_str())
+
+        .def(py::init([](const py::buffer& membership_sequence,
+                        const py::buffer& clique_size_sequence,
+                        unsigned int seed)
+                {
+                    return new BipartiteConfigurationModelGenerator(
+                            sequence_from_buffer(membership_sequence,
+                                "membership_sequence"),
+                            sequence_from_buffer(clique_size_sequence,
+                                "clique_size_sequence"), seed);
+                }), R"pbdoc(
+            Constructor of the class BipartiteConfigurationModelGenerator from
+            integer arrays (int32, int64, uint32 or uint64)
+
+            Args:
+               membership_sequence: Array of membership for the nodes
+               clique_size_sequence: Array of size for the cliques
+               seed: Seed for the RNG.
+            )pbdoc", py::arg("membership_sequence"),
+                py::arg("clique_size_sequence"), py::arg("seed") = 42)
+
+        .def(py::init<vector<unsigned int>, vector<unsigned int>,
+                unsigned int>(), R"pbdoc(
+            Default constructor of the class
+            BipartiteConfigurationModelGenerator
+
+            Args:
+               membership_sequence: Sequence of membership for the nodes
+               clique_size_sequence: Sequence of size for the cliques
+               seed: Seed for the RNG.
+            )pbdoc", py::arg("membership_sequence"),
+                py::arg("clique_size_sequence"), py::arg("seed") = 42)
+
+        .def("get_graph", [](BipartiteConfigurationModelGenerator& self,
+                    bool simple_graph, const string& output,
+                    unsigned int n_threads)
+                {
+                    OutputFormat format = parse_output(output);
+                    if (format == OutputFormat::CSR)
+                    {
+                        CSRGraph csr;
+                        {
+                            py::gil_scoped_release release;
+                            csr = self.get_graph_csr(simple_graph,
+                                    n_threads);
+                        }
+                        return py::object(csr_output(move(csr)));
+                    }
+                    EdgeList edge_list;
+                    {
+                        py::gil_scoped_release release;
+                        edge_list = self.get_graph(simple_graph,
+                                n_threads);
+                    }
+                    return edge_output(move(edge_list), format,
+                            self.number_of_nodes());
+                }, R"pbdoc(
+            Create a random node-clique incidence list (node, clique), the
+            bipartite graph of the clustered graph model without its
+            projection.
+
+            Args:
+               simple_graph: bool indicating if the bipartite graph must be
+               simple (no node twice in the same clique)
+               output: 'list' for a list of tuples, 'array' for a (S,2)
+               numpy array sharing the memory of the generated edge list,
+               'csr' for the (indptr, indices) arrays giving the cliques of
+               each node
+               n_threads: Number of threads used to shuffle the stubs when
+               there are more than 1e9 stubs, 0 to use all the cores. The
+               result does not depend on the number of threads.
+            )pbdoc", py::arg("simple_graph") = false,
+                py::arg("output") = "list", py::arg("n_threads") = 1)
+
+        .def("set_repair_budget",
+                &BipartiteConfigurationModelGenerator::set_repair_budget,
+                R"pbdoc(
+            Limit the rewiring of the bipartite multigraph into a simple
+            bipartite graph. When the budget is exhausted, get_graph returns
+            the partially rewired graph and status() is BUDGET_EXHAUSTED.
+
+            Args:
+               max_rewiring: Maximal number of rewirings, 0 for no limit
+               max_seconds: Maximal rewiring time in seconds, 0 for no limit
+            )pbdoc", py::arg("max_rewiring") = 0, py::arg("max_seconds") = 0.)
+
+        .def("status", &BipartiteConfigurationModelGenerator::status,
+                R"pbdoc(
+            Status of the rewiring for the last simple graph generated.
+            )pbdoc")
+
+        .def("is_graphical",
+                &BipartiteConfigurationModelGenerator::is_graphical, R"pbdoc(
+            Whether the sequences admit a simple bipartite graph (Gale-Ryser
+            test done at construction). get_graph(simple_graph=True) raises
+            if they do not.
+            )pbdoc");
+
+    py::class_<JointDegreeGenerator>(m,
+            ("JointDegreeGenerator" + suffix).c_str())
+
+        .def(py::init([](const py::buffer& degree_sequence,
+                        const py::buffer& joint_degree_matrix,
+                        unsigned int seed)
+                {
+                    return new JointDegreeGenerator(
+                            sequence_from_buffer(degree_sequence,
+                                "degree_sequence"),
+                            joint_degree_matrix_from_buffer(
+                                joint_degree_matrix, "joint_degree_matrix"),
+                            seed);
+                }), R"pbdoc(
+            Constructor of the class JointDegreeGenerator from integer arrays
+            (int32, int64, uint32 or uint64)
+
+            Args:
+               degree_sequence: Array of degree for the network
+               joint_degree_matrix: (M,3) array whose rows (k, l, m) give
+               the number m of edges between nodes of degree k and l. The
+               row (l, k) is either omitted or equal (symmetric matrix), and
+               m counts each edge once for k = l
+               seed: Seed for the RNG.
+            )pbdoc", py::arg("degree_sequence"),
+                py::arg("joint_degree_matrix"), py::arg("seed") = 42)
+
+        .def(py::init<vector<unsigned int>, const JointDegreeMatrix&,
+                unsigned int>(), R"pbdoc(
+            Default constructor of the class JointDegreeGenerator
+
+            Args:
+               degree_sequence: Sequence of degree for the network
+               joint_degree_matrix: Sequence of triplets (k, l, m) giving the
+               number m of edges between nodes of degree k and l. The
+               triplet (l, k) is either omitted or equal (symmetric matrix),
+               and m counts each edge once for k = l
+               seed: Seed for the RNG.
+            )pbdoc", py::arg("degree_sequence"),
+                py::arg("joint_degree_matrix"), py::arg("seed") = 42)
+
+        .def("get_graph", [](JointDegreeGenerator& self,
+                    bool simple_graph, const string& output,
+                    unsigned int n_threads)
+                {
+                    OutputFormat format = parse_output(output);
+                    if (format == OutputFormat::CSR)
+                    {
+                        CSRGraph csr;
+                        {
+                            py::gil_scoped_release release;
+                            csr = self.get_graph_csr(simple_graph,
+                                    n_threads);
+                        }
+                        return py::object(csr_output(move(csr)));
+                    }
+                    EdgeList edge_list;
+                    {
+                        py::gil_scoped_release release;
+                        edge_list = self.get_graph(simple_graph,
+                                n_threads);
+                    }
+                    return edge_output(move(edge_list), format,
+                            self.number_of_nodes());
+                }, R"pbdoc(
+            Create a random edge list with the prescribed joint degree
+            matrix, by matching the stubs of each pair of degree classes.
+
+            Args:
+               simple_graph: bool indicating if the network must be a
+               simple graph. Raises if the joint degree matrix admits no
+               simple graph (see is_graphical).
+               output: 'list' for a list of tuples, 'array' for a (E,2)
+               numpy array sharing the memory of the generated edge list,
+               'csr' for the (indptr, indices) arrays of the adjacency
+               n_threads: Number of threads, 0 to use all the cores. The
+               result does not depend on the number of threads.
+            )pbdoc", py::arg("simple_graph") = false,
+                py::arg("output") = "list", py::arg("n_threads") = 1)
 
-    py::class_<ConfigurationModelSampler>(m, "ConfigurationModelSampler")
+        .def("set_repair_budget",
+                &JointDegreeGenerator::set_repair_budget, R"pbdoc(
+            Limit the rewiring of each pair of degree classes into a simple
+            graph. When the budget is exhausted, get_graph returns the
+            partially rewired graph and status() is BUDGET_EXHAUSTED.
+
+            Args:
+               max_rewiring: Maximal number of rewirings per pair of classes,
+               0 for no limit
+               max_seconds: Maximal rewiring time in seconds per pair of
+               classes, 0 for no limit
+            )pbdoc", py::arg("max_rewiring") = 0, py::arg("max_seconds") = 0.)
+
+        .def("status", &JointDegreeGenerator::status, R"pbdoc(
+            Status of the rewiring for the last simple graph generated.
+            )pbdoc")
+
+        .def("is_graphical", &JointDegreeGenerator::is_graphical, R"pbdoc(
+            Whether the joint degree matrix admits a simple graph, i.e.
+            m_kl <= n_k n_l and m_kk <= n_k (n_k-1)/2 (test done at
+            construction). get_graph(simple_graph=True) raises if it does not.
+            )pbdoc");
+
+    py::class_<ConfigurationModelSampler>(m,
+            ("ConfigurationModelSampler" + suffix).c_str())
+
+        .def(py::init([](const py::buffer& edge_array, unsigned int seed,
+                        bool simple_graph)
+                {
+                    return new ConfigurationModelSampler(
+                            edge_list_from_buffer<NodeType>(edge_array,
+                                "edge_list"),
+                            seed, simple_graph);
+                }), R"pbdoc(
+            Constructor of the class ConfigurationModelSampler from a (E,2)
+            integer array (int32, int64, uint32 or uint64)
+
+            Args:
+               edge_list: Edge array for the initial network
+               seed: Seed for the RNG.
+               simple_graph: Bool indicating if the generated graph are simple
+            )pbdoc", py::arg("edge_list"), py::arg("seed") = 42,
+                py::arg("simple_graph") = true)
 
         .def(py::init<EdgeList, unsigned int, bool >(), R"pbdoc(
             Default constructor of the class ConfigurationModelSampler
@@ -65,15 +809,280 @@ PYBIND11_MODULE(_rggen, m)
             )pbdoc", py::arg("edge_list"), py::arg("seed") = 42,
                 py::arg("simple_graph") = true)
 
-        .def("get_graph", &ConfigurationModelSampler::get_graph,
-                R"pbdoc(
+        .def("get_graph", [](ConfigurationModelSampler& self,
+                    unsigned int step, const string& output)
+                {
+                    OutputFormat format = parse_output(output);
+                    EdgeList edge_list;
+                    {
+                        py::gil_scoped_release release;
+                        edge_list = self.get_graph(step);
+                    }
+                    return edge_output(move(edge_list), format,
+                            self.number_of_nodes());
+                }, R"pbdoc(
             Sample a random edge list after a certain number of mixing steps
 
             Args:
                step: Number of edge swap before sampling
-            )pbdoc", py::arg("step"));
+               output: 'list' for a list of tuples, 'array' for a (E,2)
+               numpy array sharing the memory of the sampled edge list,
+               'csr' for the (indptr, indices) arrays of the adjacency
+            )pbdoc", py::arg("step"), py::arg("output") = "list")
 
-    py::class_<ClusteredGraphGenerator>(m, "ClusteredGraphGenerator")
+        .def("get_graph_parallel", [](ConfigurationModelSampler& self,
+                    size_t step, unsigned int n_threads, const string& output)
+                {
+                    OutputFormat format = parse_output(output);
+                    EdgeList edge_list;
+                    {
+                        py::gil_scoped_release release;
+                        edge_list = self.get_graph_parallel(step, n_threads);
+                    }
+                    return edge_output(move(edge_list), format,
+                            self.number_of_nodes());
+                }, R"pbdoc(
+            Sample a random edge list after a certain number of mixing steps,
+            with the edge swaps performed concurrently by several threads.
+            The sample is only reproducible with n_threads = 1.
+
+            Args:
+               step: Number of edge swap before sampling
+               n_threads: Number of threads, 0 uses all hardware threads
+               output: 'list' for a list of tuples, 'array' for a (E,2)
+               numpy array sharing the memory of the sampled edge list,
+               'csr' for the (indptr, indices) arrays of the adjacency
+            )pbdoc", py::arg("step"), py::arg("n_threads") = 0,
+                py::arg("output") = "list")
+
+        .def("get_graphs", [](ConfigurationModelSampler& self, size_t k,
+                    unsigned int step, unsigned int n_threads)
+                {
+                    pair<EdgeList,vector<size_t>> graphs;
+                    {
+                        py::gil_scoped_release release;
+                        graphs = self.get_graphs(k, step, n_threads);
+                    }
+                    return py::make_tuple(edge_array(move(graphs.first)),
+                            vector_array(move(graphs.second)));
+                }, R"pbdoc(
+            Run k independent chains in parallel from the current edge list,
+            which is left unchanged. The chain i uses the stream i of the
+            RNG, the result does not depend on the number of threads.
+
+            Args:
+               k: Number of chains
+               step: Number of edge swap of each chain
+               n_threads: Number of threads, 0 to use all the cores
+
+            Returns:
+               edges: (E,2) array of the concatenated edge lists
+               offsets: array of size k+1, the edges of chain i are
+               edges[offsets[i]:offsets[i+1]]
+            )pbdoc", py::arg("k"), py::arg("step"), py::arg("n_threads") = 1)
+
+        .def("samples", [](ConfigurationModelSampler& self, size_t n,
+                    unsigned int step, py::object out)
+                {
+                    size_t n_edges = self.number_of_edges();
+                    NodeType* block;
+                    out = sample_block(out, n, n_edges, block);
+                    {
+                        py::gil_scoped_release release;
+                        self.samples(n, step, [&](size_t i,
+                                    const EdgeList& edge_list)
+                                {
+                                    memcpy(block + 2*n_edges*i,
+                                            edge_list.data(),
+                                            2*n_edges*sizeof(NodeType));
+                                });
+                    }
+                    return out;
+                }, R"pbdoc(
+            Take n samples of the chain, one every step edge swaps, and write
+            them in a single (n,E,2) array. Each sample is copied with one
+            memcpy, without creating Python objects.
+
+            Args:
+               n: Number of samples
+               step: Number of edge swap before each sample
+               out: C-contiguous (n,E,2) array of unsigned integers of the
+               width of the node indices (uint32 or uint64) receiving the
+               samples, allocated if None. A numpy.memmap writes the samples
+               directly to a file.
+
+            Returns:
+               out: Array of the samples
+            )pbdoc", py::arg("n"), py::arg("step"),
+                py::arg("out") = py::none())
+
+        .def("track_observables",
+                &ConfigurationModelSampler::track_observables, R"pbdoc(
+            Record observables of the chain every stride edge swaps, updated
+            in O(1) per swap (O(degree) for the triangles). The previous
+            series is discarded, and stride = 0 stops the tracking. The swaps
+            of get_graph_parallel are not recorded.
+
+            Args:
+               stride: Number of edge swap between two records
+               triangles: Bool indicating if the number of triangles is
+               tracked, only for simple graphs
+            )pbdoc", py::arg("stride"), py::arg("triangles") = false)
+
+        .def("observables", [](const ConfigurationModelSampler& self)
+                {
+                    const vector<SamplerObservables>& series =
+                        self.observables();
+                    vector<size_t> swaps, accepted, rejected_self_loops,
+                        rejected_multiedges, rejected_metropolis, triangles;
+                    vector<double> assortativity;
+                    for (auto& record : series)
+                    {
+                        swaps.push_back(record.swaps);
+                        accepted.push_back(record.accepted);
+                        rejected_self_loops.push_back(
+                                record.rejected_self_loops);
+                        rejected_multiedges.push_back(
+                                record.rejected_multiedges);
+                        rejected_metropolis.push_back(
+                                record.rejected_metropolis);
+                        assortativity.push_back(record.assortativity);
+                        triangles.push_back(record.triangles);
+                    }
+                    py::dict output;
+                    output["swaps"] = vector_array(move(swaps));
+                    output["accepted"] = vector_array(move(accepted));
+                    output["rejected_self_loops"] = vector_array(
+                            move(rejected_self_loops));
+                    output["rejected_multiedges"] = vector_array(
+                            move(rejected_multiedges));
+                    output["rejected_metropolis"] = vector_array(
+                            move(rejected_metropolis));
+                    output["assortativity"] = vector_array(
+                            move(assortativity));
+                    output["triangles"] = vector_array(move(triangles));
+                    return output;
+                }, R"pbdoc(
+            Time series of the tracked observables, counted since the
+            tracking started
+
+            Returns:
+               observables: dict of arrays with keys 'swaps', 'accepted',
+               'rejected_self_loops', 'rejected_multiedges',
+               'rejected_metropolis' (cumulative counts), 'assortativity'
+               (degree assortativity of the current
+               graph) and 'triangles' (0 if they are not tracked)
+            )pbdoc")
+
+        .def("set_target_transitivity",
+                &ConfigurationModelSampler::set_target_transitivity, R"pbdoc(
+            Sample simple graphs with a weight exp(-beta |t - transitivity|),
+            where t is the transitivity of the graph, using a Metropolis rule
+            on the edge swaps. The triangle delta of each swap is computed
+            from the sorted neighbors in O(degree). beta = 0 restores the
+            uniform sampling.
+
+            Args:
+               transitivity: Target transitivity, between 0 and 1
+               beta: Inverse temperature of the Metropolis rule
+            )pbdoc", py::arg("transitivity"), py::arg("beta"))
+
+        .def("transitivity", &ConfigurationModelSampler::transitivity,
+                R"pbdoc(
+            Transitivity of the current graph, nan if the triangles are
+            neither tracked nor targeted
+            )pbdoc");
+
+    py::class_<CurveballSampler>(m, ("CurveballSampler" + suffix).c_str())
+
+        .def(py::init([](const py::buffer& edge_array, unsigned int seed)
+                {
+                    return new CurveballSampler(
+                            edge_list_from_buffer<NodeType>(edge_array,
+                                "edge_list"), seed);
+                }), R"pbdoc(
+            Constructor of the class CurveballSampler from a (E,2) integer
+            array (int32, int64, uint32 or uint64) of a simple graph
+
+            Args:
+               edge_list: Edge array for the initial network
+               seed: Seed for the RNG.
+            )pbdoc", py::arg("edge_list"), py::arg("seed") = 42)
+
+        .def(py::init<const EdgeList&, unsigned int>(), R"pbdoc(
+            Default constructor of the class CurveballSampler
+
+            Args:
+               edge_list: Edge list for the initial simple graph
+               seed: Seed for the RNG.
+            )pbdoc", py::arg("edge_list"), py::arg("seed") = 42)
+
+        .def("get_graph", [](CurveballSampler& self, unsigned int step,
+                    const string& output)
+                {
+                    OutputFormat format = parse_output(output);
+                    EdgeList edge_list;
+                    {
+                        py::gil_scoped_release release;
+                        edge_list = self.get_graph(step);
+                    }
+                    return edge_output(move(edge_list), format,
+                            self.number_of_nodes());
+                }, R"pbdoc(
+            Sample a random edge list after a certain number of trades
+            between random pairs of nodes
+
+            Args:
+               step: Number of trades before sampling
+               output: 'list' for a list of tuples, 'array' for a (E,2)
+               numpy array sharing the memory of the sampled edge list,
+               'csr' for the (indptr, indices) arrays of the adjacency
+            )pbdoc", py::arg("step"), py::arg("output") = "list")
+
+        .def("get_graph_global", [](CurveballSampler& self,
+                    unsigned int step, const string& output)
+                {
+                    OutputFormat format = parse_output(output);
+                    EdgeList edge_list;
+                    {
+                        py::gil_scoped_release release;
+                        edge_list = self.get_graph_global(step);
+                    }
+                    return edge_output(move(edge_list), format,
+                            self.number_of_nodes());
+                }, R"pbdoc(
+            Sample a random edge list after a certain number of global
+            trades, each trading all the nodes in random pairs
+
+            Args:
+               step: Number of global trades before sampling
+               output: 'list' for a list of tuples, 'array' for a (E,2)
+               numpy array sharing the memory of the sampled edge list,
+               'csr' for the (indptr, indices) arrays of the adjacency
+            )pbdoc", py::arg("step"), py::arg("output") = "list");
+
+    py::class_<ClusteredGraphGenerator>(m,
+            ("ClusteredGraphGenerator" + suffix).c_str())
+
+        .def(py::init([](const py::buffer& membership_sequence,
+                        const py::buffer& clique_size_sequence,
+                        unsigned int seed)
+                {
+                    return new ClusteredGraphGenerator(
+                            sequence_from_buffer(membership_sequence,
+                                "membership_sequence"),
+                            sequence_from_buffer(clique_size_sequence,
+                                "clique_size_sequence"), seed);
+                }), R"pbdoc(
+            Constructor of the class ClusteredGraphGenerator from integer arrays
+            (int32, int64, uint32 or uint64)
+
+            Args:
+               membership_sequence: Array of group membership for each node
+               clique_size_sequence: Array of group size for each group
+               seed: Seed for the RNG.
+            )pbdoc", py::arg("membership_sequence"),
+                py::arg("clique_size_sequence"), py::arg("seed") = 42)
 
         .def(py::init<vector<unsigned int>, vector<unsigned int>,
                 unsigned int>(), R"pbdoc(
@@ -86,24 +1095,255 @@ PYBIND11_MODULE(_rggen, m)
             )pbdoc", py::arg("membership_sequence"),
                 py::arg("clique_size_sequence"), py::arg("seed") = 42)
 
-        .def("get_graph", &ClusteredGraphGenerator::get_graph,
-                R"pbdoc(
+        .def("get_graph", [](ClusteredGraphGenerator& self,
+                    const string& output, const string& clique_output,
+                    bool sorted_output, unsigned int n_threads)
+                {
+                    OutputFormat format = parse_output(output);
+                    CliqueFormat clique_format = parse_clique_output(
+                            clique_output);
+                    pair<EdgeList,CliqueMembership> graph;
+                    {
+                        py::gil_scoped_release release;
+                        graph = self.get_graph_flat(sorted_output,
+                                n_threads);
+                    }
+                    return py::make_tuple(
+                            edge_output(move(graph.first), format,
+                                self.number_of_nodes()),
+                            membership_output(move(graph.second),
+                                clique_format, true));
+                }, R"pbdoc(
             Create a random edge list from the clustered graph model.
-            )pbdoc")
 
-        .def("get_multigraph", &ClusteredGraphGenerator::get_multigraph,
-                R"pbdoc(
+            Args:
+               output: 'list' for a list of tuples, 'array' for a (E,2)
+               numpy array sharing the memory of the generated edge list,
+               'csr' for the (indptr, indices) arrays of the adjacency
+               clique_output: 'list' for a list of sets, 'flat' for the
+               (offsets, members) arrays of the clique membership
+               sorted_output: bool indicating if the edges are sorted, the
+               unsorted edges are deduplicated without sorting
+               n_threads: Number of threads, 0 to use all the cores
+            )pbdoc", py::arg("output") = "list",
+                py::arg("clique_output") = "list",
+                py::arg("sorted_output") = true, py::arg("n_threads") = 1)
+
+        .def("get_multigraph", [](ClusteredGraphGenerator& self,
+                    const string& output, const string& clique_output)
+                {
+                    OutputFormat format = parse_output(output);
+                    CliqueFormat clique_format = parse_clique_output(
+                            clique_output);
+                    pair<EdgeList,CliqueMembership> graph;
+                    {
+                        py::gil_scoped_release release;
+                        graph = self.get_multigraph_flat();
+                    }
+                    return py::make_tuple(
+                            edge_output(move(graph.first), format,
+                                self.number_of_nodes()),
+                            membership_output(move(graph.second),
+                                clique_format, false));
+                }, R"pbdoc(
             Create a random multiedge list from the clustered graph model.
-            )pbdoc")
 
-        .def("get_multigraph_2", &ClusteredGraphGenerator::get_multigraph_2,
-                R"pbdoc(
+            Args:
+               output: 'list' for a list of tuples, 'array' for a (E,2)
+               numpy array sharing the memory of the generated edge list,
+               'csr' for the (indptr, indices) arrays of the adjacency
+               clique_output: 'list' for a list of lists, 'flat' for the
+               (offsets, members) arrays of the clique membership
+            )pbdoc", py::arg("output") = "list",
+                py::arg("clique_output") = "list")
+
+        .def("get_multigraph_2", [](ClusteredGraphGenerator& self,
+                    const string& output, const string& clique_output,
+                    unsigned int n_threads)
+                {
+                    OutputFormat format = parse_output(output);
+                    if (format == OutputFormat::CSR)
+                        throw py::value_error("output must be 'list' or "
+                                "'array'");
+                    CliqueFormat clique_format = parse_clique_output(
+                            clique_output);
+                    if (format == OutputFormat::ARRAY)
+                    {
+                        pair<EdgeCounts,CliqueMembership> graph;
+                        {
+                            py::gil_scoped_release release;
+                            graph = self.get_multigraph_2_columns(n_threads);
+                        }
+                        return py::make_tuple(py::make_tuple(
+                                    vector_array(move(graph.first.first)),
+                                    vector_array(move(graph.first.second)),
+                                    vector_array(move(graph.first.count))),
+                                membership_output(move(graph.second),
+                                    clique_format, false));
+                    }
+                    pair<EdgeTriplet,CliqueMembership> graph;
+                    {
+                        py::gil_scoped_release release;
+                        graph = self.get_multigraph_2_flat(n_threads);
+                    }
+                    return py::make_tuple(py::cast(graph.first),
+                            membership_output(move(graph.second),
+                                clique_format, false));
+                }, R"pbdoc(
             Create a random multiedge list from the clustered graph model.
-            Each edge appear once as a triplet, (i,j,count).
-            )pbdoc");
+            Each edge appear once as a triplet, (i,j,count), and the
+            triplets are sorted.
 
+            Args:
+               output: 'list' for a list of triplets, 'array' for the three
+               numpy arrays (i, j, count)
+               clique_output: 'list' for a list of lists, 'flat' for the
+               (offsets, members) arrays of the clique membership
+               n_threads: Number of threads, 0 to use all the cores
+            )pbdoc", py::arg("output") = "list",
+                py::arg("clique_output") = "list", py::arg("n_threads") = 1)
 
-    py::class_<SegregatedGraphGenerator>(m, "SegregatedGraphGenerator")
+        .def("get_graphs", [](const ClusteredGraphGenerator& self,
+                    size_t k, unsigned int n_threads)
+                {
+                    pair<EdgeList,vector<size_t>> graphs;
+                    {
+                        py::gil_scoped_release release;
+                        graphs = self.get_graphs(k, n_threads);
+                    }
+                    return py::make_tuple(edge_array(move(graphs.first)),
+                            vector_array(move(graphs.second)));
+                }, R"pbdoc(
+            Create k random edge lists from the clustered graph model in
+            parallel. The realization i uses the stream i of the RNG, the
+            result does not depend on the number of threads.
+
+            Args:
+               k: Number of realizations
+               n_threads: Number of threads, 0 to use all the cores
+
+            Returns:
+               edges: (E,2) array of the concatenated edge lists
+               offsets: array of size k+1, the edges of realization i are
+               edges[offsets[i]:offsets[i+1]]
+            )pbdoc", py::arg("k"), py::arg("n_threads") = 1);
+
+
+    py::class_<ClusteredGraphSampler>(m,
+            ("ClusteredGraphSampler" + suffix).c_str())
+
+        .def(py::init([](const py::buffer& membership_sequence,
+                        const py::buffer& clique_size_sequence,
+                        unsigned int seed)
+                {
+                    return new ClusteredGraphSampler(
+                            sequence_from_buffer(membership_sequence,
+                                "membership_sequence"),
+                            sequence_from_buffer(clique_size_sequence,
+                                "clique_size_sequence"), seed);
+                }), R"pbdoc(
+            Constructor of the class ClusteredGraphSampler from integer arrays
+            (int32, int64, uint32 or uint64)
+
+            Args:
+               membership_sequence: Array of group membership for each node
+               clique_size_sequence: Array of group size for each group
+               seed: Seed for the RNG.
+            )pbdoc", py::arg("membership_sequence"),
+                py::arg("clique_size_sequence"), py::arg("seed") = 42)
+
+        .def(py::init<vector<unsigned int>, vector<unsigned int>,
+                unsigned int>(), R"pbdoc(
+            Default constructor of the class ClusteredGraphSampler
+
+            Args:
+               membership_sequence: Sequence of group membership for each node
+               clique_size_sequence: Sequence of group size for each group
+               seed: Seed for the RNG.
+            )pbdoc", py::arg("membership_sequence"),
+                py::arg("clique_size_sequence"), py::arg("seed") = 42)
+
+        .def("get_graph", [](ClusteredGraphSampler& self, unsigned int step,
+                    const string& output, const string& clique_output)
+                {
+                    OutputFormat format = parse_output(output);
+                    CliqueFormat clique_format = parse_clique_output(
+                            clique_output);
+                    pair<EdgeList,CliqueMembership> graph;
+                    {
+                        py::gil_scoped_release release;
+                        graph = self.get_graph(step);
+                    }
+                    return py::make_tuple(
+                            edge_output(move(graph.first), format,
+                                self.number_of_nodes()),
+                            membership_output(move(graph.second),
+                                clique_format, true));
+                }, R"pbdoc(
+            Sample a clustered graph after a certain number of membership
+            swaps between cliques.
+
+            Args:
+               step: Number of membership swap before sampling
+               output: 'list' for a list of tuples, 'array' for a (E,2)
+               numpy array sharing the memory of the sampled edge list,
+               'csr' for the (indptr, indices) arrays of the adjacency
+               clique_output: 'list' for a list of sets, 'flat' for the
+               (offsets, members) arrays of the clique membership
+            )pbdoc", py::arg("step"), py::arg("output") = "list",
+                py::arg("clique_output") = "list")
+
+        .def("get_edge_delta", [](ClusteredGraphSampler& self,
+                    unsigned int step, const string& output)
+                {
+                    OutputFormat format = parse_output(output);
+                    pair<EdgeList,EdgeList> delta;
+                    {
+                        py::gil_scoped_release release;
+                        delta = self.get_edge_delta(step);
+                    }
+                    return py::make_tuple(
+                            edge_output(move(delta.first), format,
+                                self.number_of_nodes()),
+                            edge_output(move(delta.second), format,
+                                self.number_of_nodes()));
+                }, R"pbdoc(
+            Perform a certain number of membership swaps and return the
+            edges of the projected graph added and removed since the last
+            sample (get_graph or get_edge_delta).
+
+            Args:
+               step: Number of membership swap before sampling
+               output: 'list' for lists of tuples, 'array' for (E,2) numpy
+               arrays
+
+            Returns:
+               added: Edges added to the projected graph
+               removed: Edges removed from the projected graph
+            )pbdoc", py::arg("step"), py::arg("output") = "list");
+
+    py::class_<SegregatedGraphGenerator>(m,
+            ("SegregatedGraphGenerator" + suffix).c_str())
+
+        .def(py::init([](const py::buffer& membership_sequence,
+                        const py::buffer& clique_size_sequence,
+                        unsigned int seed)
+                {
+                    return new SegregatedGraphGenerator(
+                            sequence_from_buffer(membership_sequence,
+                                "membership_sequence"),
+                            sequence_from_buffer(clique_size_sequence,
+                                "clique_size_sequence"), seed);
+                }), R"pbdoc(
+            Constructor of the class SegregatedGraphGenerator from integer arrays
+            (int32, int64, uint32 or uint64)
+
+            Args:
+               membership_sequence: Array of group membership for each node
+               clique_size_sequence: Array of group size for each group
+               seed: Seed for the RNG.
+            )pbdoc", py::arg("membership_sequence"),
+                py::arg("clique_size_sequence"), py::arg("seed") = 42)
 
         .def(py::init<vector<unsigned int>, vector<unsigned int>,
                 unsigned int>(), R"pbdoc(
@@ -116,14 +1356,124 @@ PYBIND11_MODULE(_rggen, m)
             )pbdoc", py::arg("membership_sequence"),
                 py::arg("clique_size_sequence"), py::arg("seed") = 42)
 
-        .def("get_graph", &SegregatedGraphGenerator::get_graph,
-                R"pbdoc(
+        .def("get_graph", [](SegregatedGraphGenerator& self,
+                    const string& output, const string& clique_output)
+                {
+                    OutputFormat format = parse_output(output);
+                    CliqueFormat clique_format = parse_clique_output(
+                            clique_output);
+                    pair<EdgeList,CliqueMembership> graph;
+                    {
+                        py::gil_scoped_release release;
+                        graph = self.get_graph_flat();
+                    }
+                    return py::make_tuple(
+                            edge_output(move(graph.first), format,
+                                self.number_of_nodes()),
+                            membership_output(move(graph.second),
+                                clique_format, true));
+                }, R"pbdoc(
             Create a random edge list from the segregated graph model.
-            )pbdoc")
 
-        .def("get_multigraph", &SegregatedGraphGenerator::get_multigraph,
-                R"pbdoc(
+            Args:
+               output: 'list' for a list of tuples, 'array' for a (E,2)
+               numpy array sharing the memory of the generated edge list,
+               'csr' for the (indptr, indices) arrays of the adjacency
+               clique_output: 'list' for a list of sets, 'flat' for the
+               (offsets, members) arrays of the clique membership
+            )pbdoc", py::arg("output") = "list",
+                py::arg("clique_output") = "list")
+
+        .def("get_multigraph", [](SegregatedGraphGenerator& self,
+                    const string& output, const string& clique_output)
+                {
+                    OutputFormat format = parse_output(output);
+                    CliqueFormat clique_format = parse_clique_output(
+                            clique_output);
+                    pair<EdgeList,CliqueMembership> graph;
+                    {
+                        py::gil_scoped_release release;
+                        graph = self.get_multigraph_flat();
+                    }
+                    return py::make_tuple(
+                            edge_output(move(graph.first), format,
+                                self.number_of_nodes()),
+                            membership_output(move(graph.second),
+                                clique_format, false));
+                }, R"pbdoc(
             Create a random multiedge list from the segregated graph model.
-            )pbdoc");
 
+            Args:
+               output: 'list' for a list of tuples, 'array' for a (E,2)
+               numpy array sharing the memory of the generated edge list,
+               'csr' for the (indptr, indices) arrays of the adjacency
+               clique_output: 'list' for a list of lists, 'flat' for the
+               (offsets, members) arrays of the clique membership
+            )pbdoc", py::arg("output") = "list",
+                py::arg("clique_output") = "list");
+
+
+    py::class_<ChungLuGenerator>(m,
+            ("ChungLuGenerator" + suffix).c_str())
+
+        .def(py::init([](py::array_t<double, py::array::c_style |
+                        py::array::forcecast> weight_sequence,
+                        unsigned int seed)
+                {
+                    if (weight_sequence.ndim() != 1)
+                        throw py::value_error(
+                                "weight_sequence must be one-dimensional");
+                    const double* data = weight_sequence.data();
+                    return new ChungLuGenerator(vector<double>(data,
+                                data + weight_sequence.size()), seed);
+                }), R"pbdoc(
+            Default constructor of the class ChungLuGenerator
+
+            Args:
+               weight_sequence: Sequence (or array) of expected degree for
+               each node
+               seed: Seed for the RNG.
+            )pbdoc", py::arg("weight_sequence"), py::arg("seed") = 42)
+
+        .def("get_graph", [](ChungLuGenerator& self, const string& output)
+                {
+                    OutputFormat format = parse_output(output);
+                    EdgeList edge_list;
+                    {
+                        py::gil_scoped_release release;
+                        edge_list = self.get_graph();
+                    }
+                    return edge_output(move(edge_list), format,
+                            self.number_of_nodes());
+                }, R"pbdoc(
+            Create a random edge list from the Chung-Lu model, where nodes
+            u and v are connected with probability min(w_u w_v / W, 1).
+
+            Args:
+               output: 'list' for a list of tuples, 'array' for a (E,2)
+               numpy array sharing the memory of the generated edge list,
+               'csr' for the (indptr, indices) arrays of the adjacency
+            )pbdoc", py::arg("output") = "list");
+}
+
+
+PYBIND11_MODULE(_rggen, m)
+{
+    py::enum_<RepairStatus>(m, "RepairStatus")
+        .value("SUCCESS", RepairStatus::SUCCESS)
+        .value("BUDGET_EXHAUSTED", RepairStatus::BUDGET_EXHAUSTED);
+
+    bind_generators<uint32_t>(m, "32");
+    bind_generators<uint64_t>(m, "64");
+
+    //the unsuffixed names are the 32 bits classes
+    for (const char* name : {"ConfigurationModelGenerator",
+            "DirectedConfigurationModelGenerator",
+            "BipartiteConfigurationModelGenerator", "JointDegreeGenerator",
+            "ConfigurationModelSampler", "CurveballSampler",
+            "ClusteredGraphGenerator", "ClusteredGraphSampler",
+            "SegregatedGraphGenerator", "ChungLuGenerator"})
+    {
+        m.attr(name) = m.attr((string(name) + "32").c_str());
+    }
 }
@@ -0,0 +1,155 @@
+/*
+ * Simple graphs of JointDegreeGenerator: an infeasible joint degree matrix is
+ * detected at construction and get_graph(simple_graph=true) throws, while a
+ * feasible one whose stubs split at random could leave a pair of classes
+ * without simple graph is generated without rewiring budget. A symmetric
+ * matrix is read as its upper triangle.
+ *
+ * g++ -O2 -std=c++11 -pthread -Isrc tests/joint_degree_graphicality.cpp \
+ *     src/GraphGenerator.cpp -o joint_degree_graphicality
+ * ./joint_degree_graphicality
+ */
+
+#include "GraphGenerator.hpp"
+#include <cstdio>
+#include <stdexcept>
+
+using namespace std;
+using namespace rggen;
+
+int failures = 0;
+
+void check(bool condition, const char* message)
+{
+    if (not condition)
+    {
+        printf("FAILED: %s\n", message);
+        failures += 1;
+    }
+}
+
+//no self-loop nor multiedge, and the joint degree matrix is preserved
+bool is_simple_realization(const EdgeList& edge_list,
+        const vector<unsigned int>& degree_sequence,
+        const JointDegreeMatrix& joint_degree_matrix)
+{
+    EdgeSet edge_set;
+    map<pair<unsigned int,unsigned int>,size_t> count;
+    for (const Edge& edge : edge_list)
+    {
+        if (edge.first == edge.second or not edge_set.insert(
+                    make_pair(min(edge.first, edge.second),
+                        max(edge.first, edge.second))).second)
+            return false;
+        unsigned int k = degree_sequence[edge.first];
+        unsigned int l = degree_sequence[edge.second];
+        count[make_pair(min(k, l), max(k, l))] += 1;
+    }
+    for (auto& entry : joint_degree_matrix)
+    {
+        unsigned int k = min(get<0>(entry), get<1>(entry));
+        unsigned int l = max(get<0>(entry), get<1>(entry));
+        if (count[make_pair(k, l)] != get<2>(entry))
+            return false;
+    }
+    return true;
+}
+
+int main()
+{
+    //m_22 = 2 > (2 choose 2): only a double edge between the two nodes
+    vector<unsigned int> degree_sequence = {2, 2};
+    JointDegreeMatrix joint_degree_matrix = {make_tuple(2, 2, 2)};
+    JointDegreeGenerator infeasible(degree_sequence, joint_degree_matrix, 42);
+    check(not infeasible.is_graphical(), "m_22 > n_2 choose 2 is graphical");
+    bool thrown = false;
+    try
+    {
+        infeasible.get_graph(true);
+    }
+    catch (const invalid_argument&)
+    {
+        thrown = true;
+    }
+    check(thrown, "get_graph(simple_graph=true) does not throw");
+    check(infeasible.get_graph(false).size() == 2, "multigraph size");
+
+    //m_24 = 4 > n_2 n_4 = 2*1: the hub has only two distinct neighbors
+    degree_sequence = {4, 2, 2};
+    joint_degree_matrix = {make_tuple(2, 4, 4)};
+    JointDegreeGenerator cross(degree_sequence, joint_degree_matrix, 42);
+    check(not cross.is_graphical(), "m_24 > n_2 n_4 is graphical");
+
+    //the stub totals of each class are checked at construction
+    degree_sequence = {2, 2, 1, 1, 1};
+    joint_degree_matrix = {make_tuple(1, 2, 3)};
+    bool mismatch = false;
+    try
+    {
+        JointDegreeGenerator(degree_sequence, joint_degree_matrix, 42);
+    }
+    catch (const invalid_argument&)
+    {
+        mismatch = true;
+    }
+    check(mismatch, "stub totals not checked");
+
+    //a symmetric matrix gives the same graphs as its upper triangle, and
+    //(k,l) and (l,k) with different counts are rejected
+    degree_sequence = {2, 2, 1, 1};
+    joint_degree_matrix = {make_tuple(2, 2, 1), make_tuple(1, 2, 2)};
+    JointDegreeMatrix symmetric_matrix = {make_tuple(2, 2, 1),
+        make_tuple(1, 2, 2), make_tuple(2, 1, 2)};
+    JointDegreeGenerator triangle(degree_sequence, joint_degree_matrix, 42);
+    JointDegreeGenerator symmetric(degree_sequence, symmetric_matrix, 42);
+    check(triangle.get_graph(true) == symmetric.get_graph(true),
+            "symmetric matrix differs from its triangle");
+    symmetric_matrix = {make_tuple(2, 2, 1), make_tuple(1, 2, 2),
+        make_tuple(2, 1, 1)};
+    bool asymmetric = false;
+    try
+    {
+        JointDegreeGenerator(degree_sequence, symmetric_matrix, 42);
+    }
+    catch (const invalid_argument&)
+    {
+        asymmetric = true;
+    }
+    check(asymmetric, "different (k,l) and (l,k) not rejected");
+
+    //A-B, A-c, B-d: the stubs of A and B must be split one per pair of
+    //classes, two stubs of A in the pair (2,2) give a self-loop
+    degree_sequence = {2, 2, 1, 1};
+    joint_degree_matrix = {make_tuple(2, 2, 1), make_tuple(1, 2, 2)};
+    JointDegreeGenerator balanced(degree_sequence, joint_degree_matrix, 42);
+    check(balanced.is_graphical(), "path of 4 nodes not graphical");
+    bool simple = true;
+    for (int i = 0; i < 1000; i++)
+    {
+        simple = simple and is_simple_realization(balanced.get_graph(true),
+                degree_sequence, joint_degree_matrix);
+    }
+    check(simple, "path of 4 nodes not simple");
+
+    //denser classes, generated with several threads
+    degree_sequence.clear();
+    degree_sequence.insert(degree_sequence.end(), 6, 5);
+    degree_sequence.insert(degree_sequence.end(), 10, 3);
+    joint_degree_matrix = {make_tuple(5, 5, 12), make_tuple(3, 5, 6),
+        make_tuple(3, 3, 12)};
+    JointDegreeGenerator dense_classes(degree_sequence, joint_degree_matrix,
+            42);
+    check(dense_classes.is_graphical(), "dense classes not graphical");
+    simple = true;
+    for (int i = 0; i < 1000; i++)
+    {
+        simple = simple and is_simple_realization(
+                dense_classes.get_graph(true, 2), degree_sequence,
+                joint_degree_matrix);
+    }
+    check(simple, "dense classes not simple");
+
+    if (failures == 0)
+        printf("OK\n");
+    return failures != 0;
+}